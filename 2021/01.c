@@ -13,7 +13,7 @@
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/01.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/01.txt"));
 
     // count the number of increases
     size_t count1 = 0;
@@ -13,7 +13,7 @@
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/02.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/02.txt"));
 
     // pilot submarine
     long position = 0;
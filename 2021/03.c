@@ -87,7 +87,7 @@ const char *compute_rating(List *input, size_t nj,
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/03.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/03.txt"));
 
     // create list of line pointers
     List *input = list_alloc(0);
@@ -69,7 +69,7 @@ void play_bingo(long *score, size_t *rank, long (*board)[5][5], size_t nb, const
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/04.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/04.txt"));
 
     // create boards
     const size_t nb = (n_lines - 1) / 6;
@@ -29,7 +29,7 @@ size_t count_overlapping(const Dict *grid) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/05.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/05.txt"));
 
     // build dict of points that are covered by line
     Dict *grid = dict_alloc(sizeof(size_t), 300000);
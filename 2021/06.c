@@ -31,7 +31,7 @@ size_t reproduce(size_t n_fish_of_age[9], size_t n) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/06.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/06.txt"));
 
     // initialize fish count
     size_t n_fish_of_age[9] = {0};
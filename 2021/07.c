@@ -61,7 +61,7 @@ long pos_cost2(const long *pos, size_t n, long p, long dp) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/07.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/07.txt"));
 
     // read crab submarine positions
     const size_t n = strcnt(line[0], ',') + 1;
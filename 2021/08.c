@@ -93,7 +93,7 @@ size_t entry_decode(const size_t common[10][10], const Entry *entry) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/08.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/08.txt"));
 
     // create entries
     Entry *entry = calloc(n_lines, sizeof(*entry));
@@ -30,7 +30,7 @@ size_t compute_basin_size(const char *map, int *seen, size_t nj) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/09.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/09.txt"));
 
     // create map with padding
     const size_t ni = n_lines + 2;
@@ -74,7 +74,7 @@ size_t complete_if_not_corrupted(const char *line) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/10.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/10.txt"));
 
     // compute syntax error score
     int score = 0;
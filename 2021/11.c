@@ -64,7 +64,7 @@ size_t simulate(int grid[N + 2][N + 2], size_t n_steps) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/11.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/11.txt"));
 
     // create Octopus grid with padding
     int grid[N + 2][N + 2] = {0};
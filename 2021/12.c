@@ -53,7 +53,7 @@ size_t dfs(size_t n, int small[n], int path[n][n], int seen[n], size_t i, size_t
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/12.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/12.txt"));
 
     // create map between names of caves and indices
     Dict *cave = dict_alloc(sizeof(size_t), 1000);
@@ -50,7 +50,7 @@ void paper_fold(const char **line, size_t ny, size_t nx, int grid[ny][nx], size_
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/13.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/13.txt"));
 
     // find separator line
     const size_t i_sep = line_find(line, n_lines, "");
@@ -61,7 +61,7 @@ size_t polymer_quantity_diff(size_t ni, const char input[ni][3], const size_t co
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/14.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/14.txt"));
 
     // read input pairs and create index map
     const size_t ni = n_lines - 2;
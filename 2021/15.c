@@ -12,13 +12,24 @@
  */
 #include "aoc.h"
 
+// tile on the dijkstra frontier, ordered by distance
+typedef struct Tile {
+    size_t dist;
+    size_t i;
+    size_t j;
+} Tile;
+
+#define TILE_LESS(a, b) ((a).dist < (b).dist)
+
+DEFINE_HEAP(Tile, TILE_LESS)
+
 size_t dijkstra(size_t ni, size_t nj, const int grid[ni][nj]) {
     // static offsets to reach neighbors
     static const long di[4] = {-1, +1, +0, +0};
     static const long dj[4] = {+0, +0, -1, +1};
 
     // set up dijkstra search
-    Heap *heap = heap_alloc(sizeof(size_t[2]), ni * nj);
+    Heap_Tile heap = {0};
     size_t(*dist)[nj] = malloc(ni * sizeof(*dist));
     for (size_t i = 1; i < ni - 1; ++i) {
         for (size_t j = 1; j < nj - 1; ++j) {
@@ -28,18 +39,17 @@ size_t dijkstra(size_t ni, size_t nj, const int grid[ni][nj]) {
     int(*visited)[nj] = calloc(ni, sizeof(*visited));
 
     // insert starting tile, set its distance to 0, and mark it as visited
-    heap_insert(heap, 0, memdup((size_t[2]){1, 1}, sizeof(size_t[2])));
+    heap_Tile_push(&heap, (Tile){0, 1, 1});
     dist[1][1] = 0;
     visited[1][1] = 1;
 
     // dijkstra
     size_t ret = 0;
-    while (heap->len > 0) {
-        // get the highest priority element (shortest distance)
-        size_t *u = heap_remove(heap);
-        const size_t ui = u[0];
-        const size_t uj = u[1];
-        free(u);
+    while (heap.len > 0) {
+        // get the tile with the shortest distance
+        const Tile u = heap_Tile_pop(&heap);
+        const size_t ui = u.i;
+        const size_t uj = u.j;
 
         // check if it is the end
         if ((ui == ni - 2) && (uj == nj - 2)) {
@@ -64,14 +74,14 @@ size_t dijkstra(size_t ni, size_t nj, const int grid[ni][nj]) {
                 // heap
                 if (alt < dist[vi][vj]) {
                     dist[vi][vj] = alt;
-                    heap_insert(heap, -alt, memdup((size_t[2]){vi, vj}, sizeof(size_t[2])));
+                    heap_Tile_push(&heap, (Tile){alt, vi, vj});
                 }
             }
         }
     }
 
 cleanup:
-    heap_free(&heap, free);
+    heap_Tile_free(&heap);
     free(dist);
     free(visited);
     return ret;
@@ -150,7 +160,7 @@ cleanup:
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/15.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/15.txt"));
 
     // create grid with padding
     const size_t ni = n_lines + 2;
@@ -166,7 +166,7 @@ void packet_free(Packet *packet) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/16.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/16.txt"));
 
     // convert hex to binary
     char *input_ptr = hex_to_bin(line[0]);
@@ -83,7 +83,7 @@ size_t probe_hit_count(const Vec *min, const Vec *max) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/17.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/17.txt"));
 
     // read target area
     Vec min, max;
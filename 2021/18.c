@@ -245,7 +245,7 @@ long pair_magnitude(const Pair *pair) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/18.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/18.txt"));
 
     // sum pairs
     Pair *sum = pair_alloc(&(const char *){line[0]}, 0);
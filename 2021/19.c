@@ -141,7 +141,7 @@ size_t manhatten(const long a[3], const long b[3]) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/19.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/19.txt"));
 
     // create scanners
     size_t nb_tot = 0;
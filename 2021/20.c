@@ -68,7 +68,7 @@ size_t image_count_pixels(const char *image, size_t ni, size_t nj) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/20.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/20.txt"));
 
     // get image enhancement algorithm
     const char *enhance = line[0];
@@ -82,7 +82,7 @@ void play_with_dirac_die(size_t p0, size_t p1, size_t s0, size_t s1, size_t *w0_
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/21.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/21.txt"));
 
     // get starting position
     size_t p0 = 0;
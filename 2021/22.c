@@ -114,7 +114,7 @@ size_t cube_sum_volume(const List *cubes) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/22.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/22.txt"));
 
     // create cubes
     List *cubes1 = list_alloc(sizeof(Cube));
@@ -130,6 +130,7 @@ long dijkstra(const char *burrow) {
         if (!strncmp(state, solution, nb)) {
             goto cleanup;
         }
+        profile_count("states expanded", 1);
 
         // insert all possible moves
         size_t move[NM][2] = {0};
@@ -166,11 +167,15 @@ cleanup:
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/23.txt");
+    size_t n_lines = 0;
+    PROFILE("parse") {
+        n_lines = lines_read(&line, input_path("2021/input/23.txt"));
+    }
 
     // create initial burrow
     char burrow[NB] = "";
     memcpy(burrow, &line[1][1], NH * sizeof(*burrow));
+    PROFILE("parse")
     for (size_t s = 0; s < 2; ++s) {
         for (size_t r = 0; r < NR; ++r) {
             burrow[NH + s * NR + r] = line[2 + s][3 + 2 * r];
@@ -178,14 +183,18 @@ int main(void) {
     }
 
     // part 1
-    printf("%ld\n", dijkstra(burrow));
+    PROFILE("part 1") {
+        printf("%ld\n", dijkstra(burrow));
+    }
 
     // update starting position
     memcpy(&burrow[NH + 3 * NR], &burrow[NH + NR], 4);
     memcpy(&burrow[NH + NR], "DCBADBAC", 8);
 
     // part 2
-    printf("%ld\n", dijkstra(burrow));
+    PROFILE("part 2") {
+        printf("%ld\n", dijkstra(burrow));
+    }
 
     // cleanup
     lines_free(line, n_lines);
@@ -31,7 +31,7 @@ long alu_chunk_func(Parameters param, long z, long w) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/24.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/24.txt"));
 
     // read parameters
     Parameters Param[NI] = {0};
@@ -12,7 +12,7 @@
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2021/input/25.txt");
+    const size_t n_lines = lines_read(&line, input_path("2021/input/25.txt"));
 
     // read map
     const size_t ni = n_lines;
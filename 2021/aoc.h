@@ -1,5 +1,9 @@
 #pragma once
 
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
 #include <assert.h>
 #include <ctype.h>
 #include <limits.h>
@@ -9,8 +13,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <tgmath.h>
+#include <time.h>
 
 #include "dict.h"
+#include "generic.h"
 #include "heap.h"
 #include "list.h"
 #include "memory.h"
@@ -34,6 +40,12 @@
         b = swap;               \
     } while (0)
 
+// time the following block as phase "name" when AOC_PROFILE=1, do not leave it with break
+#define PROFILE(name) _PROFILE(name, _PROFILE_CAT(_profile_timer_, __LINE__))
+#define _PROFILE(name, t) for (Timer t = profile_start(name); t.active; profile_stop(&t))
+#define _PROFILE_CAT(a, b) _PROFILE_CAT2(a, b)
+#define _PROFILE_CAT2(a, b) a##b
+
 // simple key creation macro
 #define KEY(k, ...) (snprintf(k, sizeof(k), __VA_ARGS__), k)
 
@@ -50,6 +62,12 @@
         return (*(T *)a < *(T *)b) - (*(T *)a > *(T *)b); \
     }
 
+// input file of a puzzle, overridden by the AOC_INPUT environment variable
+const char *input_path(const char *fname) {
+    const char *env = getenv("AOC_INPUT");
+    return env && *env ? env : fname;
+}
+
 // read all lines in file "fname" into lines, replace '\n' with '\0'
 size_t lines_read(const char ***line, const char *fname) {
     // open file
@@ -107,3 +125,89 @@ size_t line_find(const char **line, size_t n_lines, const char *find) {
     }
     assert(0 && "No matching line found.");
 }
+
+// profiling state: one slot per named phase or counter
+#define PROFILE_SLOTS 64
+typedef struct Slot {
+    const char *name;
+    long calls;
+    long count;
+    double seconds;
+} Slot;
+typedef struct Timer {
+    const char *name;
+    int active;
+    double start;
+} Timer;
+static struct {
+    int enabled;
+    size_t n_slots;
+    Slot slot[PROFILE_SLOTS];
+} profile_state = {.enabled = -1};
+
+// monotonic wall clock in seconds
+double profile_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// print all phases and counters to stderr
+void profile_report(void) {
+    fprintf(stderr, "%-24s %10s %12s %14s\n", "phase", "calls", "time [ms]", "count");
+    for (size_t i = 0; i < profile_state.n_slots; ++i) {
+        const Slot *slot = &profile_state.slot[i];
+        fprintf(stderr, "%-24s %10ld %12.3f %14ld\n", slot->name, slot->calls,
+                1e3 * slot->seconds, slot->count);
+    }
+}
+
+// check AOC_PROFILE once, and register the report if it is set
+int profile_enabled(void) {
+    if (profile_state.enabled < 0) {
+        const char *env = getenv("AOC_PROFILE");
+        profile_state.enabled = env && strcmp(env, "0");
+        if (profile_state.enabled) {
+            atexit(profile_report);
+        }
+    }
+    return profile_state.enabled;
+}
+
+// find or create the slot for "name"
+Slot *profile_slot(const char *name) {
+    for (size_t i = 0; i < profile_state.n_slots; ++i) {
+        if (profile_state.slot[i].name == name || !strcmp(profile_state.slot[i].name, name)) {
+            return &profile_state.slot[i];
+        }
+    }
+    assert(profile_state.n_slots < PROFILE_SLOTS && "Too many profiling slots.");
+    Slot *slot = &profile_state.slot[profile_state.n_slots++];
+    slot->name = name;
+    return slot;
+}
+
+// start a timer, it only reads the clock when profiling is enabled
+Timer profile_start(const char *name) {
+    if (!profile_enabled()) {
+        return (Timer){.active = 1};
+    }
+    return (Timer){name, 1, profile_clock()};
+}
+
+// stop a timer and add its elapsed time to its phase
+void profile_stop(Timer *timer) {
+    if (timer->name) {
+        Slot *slot = profile_slot(timer->name);
+        slot->calls += 1;
+        slot->seconds += profile_clock() - timer->start;
+    }
+    timer->active = 0;
+}
+
+// add "count" to the named counter
+void profile_count(const char *name, long count) {
+    if (profile_enabled()) {
+        profile_slot(name)->count += count;
+    }
+}
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "memory.h"
 
+// hash function of dict keys, select with -DDICT_HASH=DICT_HASH_FNV1A to use the old one
+#define DICT_HASH_FNV1A 1  // byte at a time
+#define DICT_HASH_WYMUM 2  // word at a time with 128-bit multiply-fold mixing
+#ifndef DICT_HASH
+#define DICT_HASH DICT_HASH_WYMUM
+#endif
+
 // dict is a collection of items
 typedef struct Dict Dict;
 typedef struct Item Item;
@@ -20,14 +28,16 @@ struct Dict {
 struct Item {
     const char *key;  // pointer to item key
     size_t key_size;  // key size
+    size_t hash;      // full hash of key
     void *data;       // pointer to item data
     Item *next;       // pointer to next item in bucket
 };
 
-Item *_item_alloc(const char *key, size_t key_size, void *data) {
+Item *_item_alloc(const char *key, size_t key_size, size_t hash, void *data) {
     const Item item = {
         .key = memdup(key, key_size + 1),
         .key_size = key_size,
+        .hash = hash,
         .data = data,
     };
     return memdup(&item, sizeof(item));
@@ -37,6 +47,7 @@ void _item_clear(Item *item, void (*data_free)(void *)) {
     free((void *)item->key);
     item->key = 0;
     item->key_size = 0;
+    item->hash = 0;
     if (data_free) {
         data_free(item->data);
         item->data = 0;
@@ -59,26 +70,65 @@ Dict *dict_alloc(size_t data_size, size_t size) {
     return memdup(&dict, sizeof(dict));
 }
 
-size_t _hash(const char *str) {
+#if DICT_HASH == DICT_HASH_FNV1A
+size_t _hash(const char *key, size_t key_size) {
     // source: https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
     size_t hash = 14695981039346656037ULL;
-    unsigned char c;
-    while ((c = *str++)) {
-        hash ^= c;
+    for (size_t i = 0; i < key_size; ++i) {
+        hash ^= (unsigned char)key[i];
         hash *= 1099511628211ULL;
     }
     return hash;
 }
+#elif DICT_HASH == DICT_HASH_WYMUM
+// multiply to 128 bits and fold the halves, the mixing step of wyhash
+uint64_t _mum(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ const unsigned __int128 r = (unsigned __int128)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+    // schoolbook multiply of the 32-bit halves
+    const uint64_t ll = (a & 0xffffffff) * (b & 0xffffffff);
+    const uint64_t lh = (a & 0xffffffff) * (b >> 32);
+    const uint64_t hl = (a >> 32) * (b & 0xffffffff);
+    const uint64_t hh = (a >> 32) * (b >> 32);
+    const uint64_t mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    const uint64_t lo = (mid << 32) | (ll & 0xffffffff);
+    const uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return lo ^ hi;
+#endif
+}
 
-int _keycmp(const char *key1, size_t key_size1, const char *key2, size_t key_size2) {
-    if (key_size1 != key_size2) {
-        return 1;
+size_t _hash(const char *key, size_t key_size) {
+    // inspired by: https://github.com/wangyi-fudan/wyhash
+    uint64_t hash = 0xa0761d6478bd642fULL ^ key_size;
+    uint64_t word = 0;
+    for (; key_size >= 8; key += 8, key_size -= 8) {
+        memcpy(&word, key, 8);
+        hash = _mum(hash ^ word, 0xe7037ed1a0b428dbULL);
+    }
+    // tail of 0 to 7 bytes, read with fixed-size loads that overlap
+    word = 0;
+    if (key_size >= 4) {
+        uint32_t lo = 0;
+        uint32_t hi = 0;
+        memcpy(&lo, key, 4);
+        memcpy(&hi, key + key_size - 4, 4);
+        word = ((uint64_t)lo << 32) | hi;
     }
-    while (*key1 && (*key1 == *key2)) {
-        ++key1;
-        ++key2;
+    else if (key_size > 0) {
+        word = ((uint64_t)(unsigned char)key[0] << 16) |
+               ((uint64_t)(unsigned char)key[key_size / 2] << 8) | (unsigned char)key[key_size - 1];
     }
-    return !(*key1 == *key2);
+    return _mum(hash ^ word ^ 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL);
+}
+#else
+#error "Unknown DICT_HASH."
+#endif
+
+// return 0 if item holds the key, compare the cached hash first
+int _keycmp(const Item *item, const char *key, size_t key_size, size_t hash) {
+    return item->hash != hash || item->key_size != key_size || memcmp(item->key, key, key_size);
 }
 
 // insert data into dict with specified key,
@@ -87,15 +137,15 @@ int _keycmp(const char *key1, size_t key_size1, const char *key2, size_t key_siz
 // return 0 if key not present
 void *dict_insert(Dict *dict, const char *key, void *data) {
     const size_t key_size = strlen(key);
-    const size_t i = _hash(key) % dict->size;
-    Item *item = &dict->item[i];
+    const size_t hash = _hash(key, key_size);
+    Item *item = &dict->item[hash % dict->size];
     Item *prev = item;
-    while (item && item->key && _keycmp(item->key, item->key_size, key, key_size)) {
+    while (item && item->key && _keycmp(item, key, key_size, hash)) {
         prev = item;
         item = item->next;
     }
     if (!item) {  // collision: append item
-        item = _item_alloc(key, key_size, data);
+        item = _item_alloc(key, key_size, hash, data);
         prev->next = item;
         ++dict->len;
         return 0;
@@ -103,6 +153,7 @@ void *dict_insert(Dict *dict, const char *key, void *data) {
     if (!item->key) {  // empty spot: insert item
         item->key = memdup(key, key_size + 1);
         item->key_size = key_size;
+        item->hash = hash;
         item->data = data;
         ++dict->len;
         return 0;
@@ -158,10 +209,10 @@ void dict_free(Dict **dict, void (*data_free)(void *)) {
 // return 0 if key not present
 void *dict_remove(Dict *dict, const char *key) {
     const size_t key_size = strlen(key);
-    const size_t i = _hash(key) % dict->size;
-    Item *item = &dict->item[i];
+    const size_t hash = _hash(key, key_size);
+    Item *item = &dict->item[hash % dict->size];
     Item *prev = 0;
-    while (item && item->key && _keycmp(item->key, item->key_size, key, key_size)) {
+    while (item && item->key && _keycmp(item, key, key_size, hash)) {
         prev = item;
         item = item->next;
     }
@@ -191,9 +242,9 @@ void *dict_remove(Dict *dict, const char *key) {
 // return 0 if key not present
 Item *dict_find(const Dict *dict, const char *key) {
     const size_t key_size = strlen(key);
-    const size_t i = _hash(key) % dict->size;
-    Item *item = &dict->item[i];
-    while (item && item->key && _keycmp(item->key, item->key_size, key, key_size)) {
+    const size_t hash = _hash(key, key_size);
+    Item *item = &dict->item[hash % dict->size];
+    while (item && item->key && _keycmp(item, key, key_size, hash)) {
         item = item->next;
     }
     return (!item || !item->key ? 0 : item);
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory.h"
+
+// type-specialized containers that store their elements inline,
+// T, K, and V have to be single identifiers (use a typedef for "unsigned long" or "char *"),
+// LESS(a, b), HASH(k), and EQ(a, b) can be functions or function-like macros
+
+// comparison, hash, and equality helpers for scalar types
+#define LESS_VALUE(a, b) ((a) < (b))
+#define EQ_VALUE(a, b) ((a) == (b))
+#define HASH_VALUE(k) hash_u64((uint64_t)(k))
+
+// finalizer of splitmix64, a good hash for integers
+static inline uint64_t hash_u64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// growable array: Vec_T with vec_T_push, vec_T_pop, and vec_T_free, index v.data directly
+#define DEFINE_VEC(T)                                                   \
+    typedef struct Vec_##T {                                            \
+        size_t len;                                                     \
+        size_t cap;                                                     \
+        T *data;                                                        \
+    } Vec_##T;                                                          \
+    static inline void vec_##T##_reserve(Vec_##T *v, size_t cap) {      \
+        if (cap > v->cap) {                                             \
+            v->cap = (cap > 2 * v->cap ? cap : 2 * v->cap);             \
+            v->data = realloc(v->data, v->cap * sizeof(T));             \
+        }                                                               \
+    }                                                                   \
+    static inline void vec_##T##_push(Vec_##T *v, T x) {                \
+        vec_##T##_reserve(v, v->len + 1);                               \
+        v->data[v->len++] = x;                                          \
+    }                                                                   \
+    static inline T vec_##T##_pop(Vec_##T *v) {                         \
+        return v->data[--v->len];                                       \
+    }                                                                   \
+    static inline void vec_##T##_free(Vec_##T *v) {                     \
+        free(v->data);                                                  \
+        *v = (Vec_##T){0};                                              \
+    }
+
+// in-place sort of an array of T: sort_T(a, n), quicksort that finishes with insertion sort
+#define DEFINE_SORT(T, LESS)                                            \
+    static inline void sort_##T(T *a, size_t n) {                       \
+        while (n > 16) {                                                \
+            T pivot = a[n / 2];                                         \
+            size_t i = 0;                                               \
+            size_t j = n - 1;                                           \
+            for (;;) {                                                  \
+                while (LESS(a[i], pivot)) ++i;                          \
+                while (LESS(pivot, a[j])) --j;                          \
+                if (i >= j) break;                                      \
+                T swap = a[i];                                          \
+                a[i++] = a[j];                                          \
+                a[j--] = swap;                                          \
+            }                                                           \
+            if (j + 1 < n - j - 1) {                                    \
+                sort_##T(a, j + 1);                                     \
+                a += j + 1;                                             \
+                n -= j + 1;                                             \
+            }                                                           \
+            else {                                                      \
+                sort_##T(a + j + 1, n - j - 1);                         \
+                n = j + 1;                                              \
+            }                                                           \
+        }                                                               \
+        for (size_t i = 1; i < n; ++i) {                                \
+            T x = a[i];                                                 \
+            size_t j = i;                                               \
+            for (; j > 0 && LESS(x, a[j - 1]); --j) a[j] = a[j - 1];    \
+            a[j] = x;                                                   \
+        }                                                               \
+    }
+
+// binary heap with the LESS element on top: Heap_T with heap_T_push, heap_T_pop, heap_T_free
+#define DEFINE_HEAP(T, LESS)                                            \
+    typedef struct Heap_##T {                                           \
+        size_t len;                                                     \
+        size_t cap;                                                     \
+        T *data;                                                        \
+    } Heap_##T;                                                         \
+    static inline void heap_##T##_push(Heap_##T *h, T x) {              \
+        if (h->len == h->cap) {                                         \
+            h->cap = (h->cap ? 2 * h->cap : 16);                        \
+            h->data = realloc(h->data, h->cap * sizeof(T));             \
+        }                                                               \
+        size_t i = h->len++;                                            \
+        while (i > 0 && LESS(x, h->data[(i - 1) / 2])) {                \
+            h->data[i] = h->data[(i - 1) / 2];                          \
+            i = (i - 1) / 2;                                            \
+        }                                                               \
+        h->data[i] = x;                                                 \
+    }                                                                   \
+    static inline T heap_##T##_pop(Heap_##T *h) {                       \
+        T top = h->data[0];                                             \
+        T x = h->data[--h->len];                                        \
+        size_t i = 0;                                                   \
+        for (size_t c = 1; c < h->len; c = 2 * i + 1) {                 \
+            if (c + 1 < h->len && LESS(h->data[c + 1], h->data[c])) ++c; \
+            if (!LESS(h->data[c], x)) break;                            \
+            h->data[i] = h->data[c];                                    \
+            i = c;                                                      \
+        }                                                               \
+        if (h->len) h->data[i] = x;                                     \
+        return top;                                                     \
+    }                                                                   \
+    static inline void heap_##T##_free(Heap_##T *h) {                   \
+        free(h->data);                                                  \
+        *h = (Heap_##T){0};                                             \
+    }
+
+// open addressing hash map with linear probing: Map_K_V with map_K_V_get, map_K_V_put,
+// map_K_V_remove, and map_K_V_free, iterate over all i < m.cap with m.used[i]
+#define DEFINE_MAP(K, V, HASH, EQ)                                                   \
+    typedef struct Map_##K##_##V {                                                   \
+        size_t len;                                                                  \
+        size_t cap;                                                                  \
+        char *used;                                                                  \
+        K *key;                                                                      \
+        V *val;                                                                      \
+    } Map_##K##_##V;                                                                 \
+    static inline size_t map_##K##_##V##_slot(const Map_##K##_##V *m, K k) {         \
+        size_t i = (size_t)(HASH(k)) & (m->cap - 1);                                 \
+        while (m->used[i] && !(EQ(m->key[i], k))) i = (i + 1) & (m->cap - 1);        \
+        return i;                                                                    \
+    }                                                                                \
+    static inline V *map_##K##_##V##_get(const Map_##K##_##V *m, K k) {              \
+        if (!m->cap) return 0;                                                       \
+        const size_t i = map_##K##_##V##_slot(m, k);                                 \
+        return (m->used[i] ? &m->val[i] : 0);                                        \
+    }                                                                                \
+    static inline V *map_##K##_##V##_put(Map_##K##_##V *m, K k, V v);                \
+    static inline void map_##K##_##V##_grow(Map_##K##_##V *m) {                      \
+        Map_##K##_##V old = *m;                                                      \
+        m->len = 0;                                                                  \
+        m->cap = (old.cap ? 2 * old.cap : 16);                                       \
+        m->used = calloc(m->cap, sizeof(*m->used));                                  \
+        m->key = malloc(m->cap * sizeof(K));                                         \
+        m->val = malloc(m->cap * sizeof(V));                                         \
+        for (size_t i = 0; i < old.cap; ++i) {                                       \
+            if (old.used[i]) map_##K##_##V##_put(m, old.key[i], old.val[i]);         \
+        }                                                                            \
+        free(old.used);                                                              \
+        free(old.key);                                                               \
+        free(old.val);                                                               \
+    }                                                                                \
+    static inline V *map_##K##_##V##_put(Map_##K##_##V *m, K k, V v) {              \
+        if (4 * (m->len + 1) > 3 * m->cap) map_##K##_##V##_grow(m);                  \
+        const size_t i = map_##K##_##V##_slot(m, k);                                 \
+        if (!m->used[i]) {                                                           \
+            m->used[i] = 1;                                                          \
+            m->key[i] = k;                                                           \
+            ++m->len;                                                                \
+        }                                                                            \
+        m->val[i] = v;                                                               \
+        return &m->val[i];                                                           \
+    }                                                                                \
+    static inline int map_##K##_##V##_remove(Map_##K##_##V *m, K k) {                \
+        if (!m->cap) return 0;                                                       \
+        size_t i = map_##K##_##V##_slot(m, k);                                       \
+        if (!m->used[i]) return 0;                                                   \
+        for (size_t j = (i + 1) & (m->cap - 1); m->used[j]; j = (j + 1) & (m->cap - 1)) { \
+            const size_t home = (size_t)(HASH(m->key[j])) & (m->cap - 1);            \
+            if (((j - home) & (m->cap - 1)) >= ((j - i) & (m->cap - 1))) {           \
+                m->key[i] = m->key[j];                                               \
+                m->val[i] = m->val[j];                                               \
+                i = j;                                                               \
+            }                                                                        \
+        }                                                                            \
+        m->used[i] = 0;                                                              \
+        --m->len;                                                                    \
+        return 1;                                                                    \
+    }                                                                                \
+    static inline void map_##K##_##V##_free(Map_##K##_##V *m) {                      \
+        free(m->used);                                                               \
+        free(m->key);                                                                \
+        free(m->val);                                                                \
+        *m = (Map_##K##_##V){0};                                                     \
+    }
@@ -15,6 +15,8 @@ struct List {
     size_t len;              // length of list
     Node *first;             // first node of list
     Node *last;              // last node of list
+    Node **vec;              // node array in list order in vector mode, else 0
+    size_t vec_size;         // maximum length of node array
 };
 
 struct Node {
@@ -43,6 +45,47 @@ List *list_alloc(size_t data_size) {
     return memdup(&list, sizeof(list));
 }
 
+// grow node array to hold at least size nodes
+void _vec_reserve(List *list, size_t size) {
+    if (size > list->vec_size) {
+        list->vec_size = (size > 2 * list->vec_size ? size : 2 * list->vec_size);
+        list->vec = realloc(list->vec, list->vec_size * sizeof(*list->vec));
+    }
+}
+
+// switch list to vector mode, which keeps an array of the nodes in list order,
+// list_get becomes O(1) and list_insert and list_remove find their node in O(1) and shift the
+// array with memmove, nodes must then only be relinked through the list functions
+void list_vectorize(List *list) {
+    _vec_reserve(list, list->len ? list->len : 1);
+    Node *node = list->first;
+    for (size_t i = 0; i < list->len; ++i) {
+        list->vec[i] = node;
+        node = node->next;
+    }
+}
+
+// return node at specified location, which must be in range
+Node *_node_get(const List *list, size_t i) {
+    if (list->vec) {  // look up in node array
+        return list->vec[i];
+    }
+    Node *node = 0;
+    if (i <= list->len - 1 - i) {  // search forward
+        node = list->first;
+        for (size_t j = 0; j < i; ++j) {
+            node = node->next;
+        }
+    }
+    else {  // search backward
+        node = list->last;
+        for (size_t j = 0; j < list->len - 1 - i; ++j) {
+            node = node->prev;
+        }
+    }
+    return node;
+}
+
 // insert data into list at specified location,
 // return 1 on out of range failure
 int list_insert(List *list, size_t i, void *data) {
@@ -65,24 +108,17 @@ int list_insert(List *list, size_t i, void *data) {
         list->last = node;
     }
     else {  // insert in middle
-        Node *next = 0;
-        if (i <= list->len - 1 - i) {  // search forward
-            next = list->first;
-            for (size_t j = 0; j < i; ++j) {
-                next = next->next;
-            }
-        }
-        else {  // search backward
-            next = list->last;
-            for (size_t j = 0; j < list->len - 1 - i; ++j) {
-                next = next->prev;
-            }
-        }
+        Node *next = _node_get(list, i);
         node->next = next;
         node->prev = next->prev;
         node->next->prev = node;
         node->prev->next = node;
     }
+    if (list->vec) {  // shift node array
+        _vec_reserve(list, list->len + 1);
+        memmove(&list->vec[i + 1], &list->vec[i], (list->len - i) * sizeof(*list->vec));
+        list->vec[i] = node;
+    }
     ++list->len;  // increment length
     return 0;
 }
@@ -108,6 +144,9 @@ List *list_copy(const List *other, void *(*data_copy)(void *, const void *, size
         }
         list_insert_last(list, copy);
     }
+    if (other->vec) {  // keep vector mode
+        list_vectorize(list);
+    }
     return list;
 }
 
@@ -120,6 +159,7 @@ void list_free(List **list, void (*data_free)(void *)) {
         _node_free(node, data_free);
         node = next;
     }
+    free((*list)->vec);
     free(*list);
     *list = 0;
 }
@@ -147,22 +187,14 @@ void *list_remove(List *list, size_t i) {
         list->last = node->prev;
         list->last->next = 0;
     }
-    else {                             // remove in middle
-        if (i <= list->len - 1 - i) {  // search forward
-            node = list->first;
-            for (size_t j = 0; j < i; ++j) {
-                node = node->next;
-            }
-        }
-        else {  // search backward
-            node = list->last;
-            for (size_t j = 0; j < list->len - 1 - i; ++j) {
-                node = node->prev;
-            }
-        }
+    else {  // remove in middle
+        node = _node_get(list, i);
         node->next->prev = node->prev;
         node->prev->next = node->next;
     }
+    if (list->vec) {  // shift node array
+        memmove(&list->vec[i], &list->vec[i + 1], (list->len - 1 - i) * sizeof(*list->vec));
+    }
     void *data = node->data;
     _node_free(node, 0);
     --list->len;  // decrement length
@@ -188,20 +220,7 @@ Node *list_get(const List *list, size_t i) {
         return list->last;
     }
     // return in middle node
-    Node *node = 0;
-    if (i <= list->len - 1 - i) {  // search forward
-        node = list->first;
-        for (size_t j = 0; j < i; ++j) {
-            node = node->next;
-        }
-    }
-    else {  // search backward
-        node = list->last;
-        for (size_t j = 0; j < list->len - 1 - i; ++j) {
-            node = node->prev;
-        }
-    }
-    return node;
+    return _node_get(list, i);
 }
 
 // search for first occurrence of data in list,
@@ -219,7 +238,18 @@ Node *list_find(const List *list, const void *data, int (*data_cmp)(const void *
 // delete specified node,
 // return data pointer
 void *list_delete(List *list, Node *node) {
-    if (node == list->first) {  // delete first node
+    if (list->vec) {  // find node in node array and shift array
+        size_t i = 0;
+        while (list->vec[i] != node) {
+            ++i;
+        }
+        memmove(&list->vec[i], &list->vec[i + 1], (list->len - 1 - i) * sizeof(*list->vec));
+    }
+    if (list->len == 1) {  // delete only node
+        list->first = 0;
+        list->last = 0;
+    }
+    else if (node == list->first) {  // delete first node
         list->first = list->first->next;
         list->first->prev = 0;
     }
@@ -262,14 +292,62 @@ void *list_to_array(const List *list) {
     return data;
 }
 
-// sort list in place,
+// merge two sorted chains of nodes linked by next, ties are taken from a to keep the order stable,
+// return first node of merged chain
+Node *_node_merge(Node *a, Node *b, int (*data_cmp)(const void *, const void *)) {
+    Node head = {0};
+    Node *tail = &head;
+    while (a && b) {
+        if (data_cmp(a->data, b->data) <= 0) {
+            tail->next = a;
+            a = a->next;
+        }
+        else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = (a ? a : b);
+    return head.next;
+}
+
+// sort list in place with a stable merge sort that relinks the nodes,
+// nodes keep their data, so pointers to nodes and data stay valid
 void list_sort(List *list, int (*data_cmp)(const void *, const void *)) {
-    char *data = list_to_array(list);
-    qsort(data, list->len, list->data_size, data_cmp);
+    if (list->len < 2) {
+        return;
+    }
+
+    // bottom-up merge sort, bin[k] holds a sorted chain of 2^k nodes or is empty
+    Node *bin[64] = {0};
     Node *node = list->first;
-    for (size_t i = 0; i < list->len; ++i) {  // shallow copy to list
-        memcpy(node->data, data + i * list->data_size, list->data_size);
+    while (node) {
+        Node *chain = node;
         node = node->next;
+        chain->next = 0;
+        size_t k = 0;
+        for (; bin[k]; ++k) {  // merge equal sized chains, earlier nodes come first
+            chain = _node_merge(bin[k], chain, data_cmp);
+            bin[k] = 0;
+        }
+        bin[k] = chain;
+    }
+    Node *first = 0;
+    for (size_t k = 0; k < 64; ++k) {  // merge remaining chains, larger chains are earlier
+        if (bin[k]) {
+            first = (first ? _node_merge(bin[k], first, data_cmp) : bin[k]);
+        }
+    }
+
+    // restore previous links, first and last node, and node array
+    list->first = first;
+    first->prev = 0;
+    for (node = first; node->next; node = node->next) {
+        node->next->prev = node;
+    }
+    list->last = node;
+    if (list->vec) {
+        list_vectorize(list);
     }
-    free(data);
 }
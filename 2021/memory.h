@@ -1,12 +1,83 @@
 #pragma once
 
 #include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
+
+// allocation accounting, enabled at runtime with AOC_MEMSTAT=1
+#define MEMSTAT_BUCKETS 64
+#define MEMSTAT_CACHE 4096
+enum { MEMSTAT_MALLOC, MEMSTAT_CALLOC, MEMSTAT_REALLOC, MEMSTAT_KINDS };
+static struct {
+    int enabled;
+    uintptr_t realloc_from;             // source address of the realloc in progress
+    size_t count[MEMSTAT_KINDS];        // number of calls per allocation function
+    size_t bytes;                       // total number of requested bytes
+    size_t copied;                      // bytes moved by realloc (estimate on cache miss)
+    size_t histogram[MEMSTAT_BUCKETS];  // requests with size in [2^i, 2^(i+1))
+    struct {
+        uintptr_t ptr;
+        size_t size;
+    } cache[MEMSTAT_CACHE];  // recent allocation sizes, used to size realloc copies
+} memstat = {.enabled = -1};
+
+// print allocation statistics and peak memory to stderr
+void memstat_report(void) {
+    fprintf(stderr, "memstat: %zu malloc, %zu calloc, %zu realloc\n", memstat.count[MEMSTAT_MALLOC],
+            memstat.count[MEMSTAT_CALLOC], memstat.count[MEMSTAT_REALLOC]);
+    fprintf(stderr, "memstat: %zu bytes requested, %zu bytes copied by realloc\n", memstat.bytes,
+            memstat.copied);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(stderr, "memstat: %ld kB peak resident\n", usage.ru_maxrss);
+    for (size_t i = 0; i < MEMSTAT_BUCKETS; ++i) {
+        if (memstat.histogram[i]) {
+            fprintf(stderr, "memstat: %14zu B+ %12zu\n", (size_t)1 << i, memstat.histogram[i]);
+        }
+    }
+}
+
+// check AOC_MEMSTAT once, and register the report if it is set
+int memstat_enabled(void) {
+    if (memstat.enabled < 0) {
+        const char *env = getenv("AOC_MEMSTAT");
+        memstat.enabled = env && strcmp(env, "0");
+        if (memstat.enabled) {
+            atexit(memstat_report);
+        }
+    }
+    return memstat.enabled;
+}
+
+// record one allocation of "size" bytes at "ptr", "old" is the realloc source address
+void memstat_record(int kind, uintptr_t old, uintptr_t ptr, size_t size) {
+    if (!memstat_enabled()) {
+        return;
+    }
+    memstat.count[kind] += 1;
+    memstat.bytes += size;
+    size_t bucket = 0;
+    while (size >> (bucket + 1)) {
+        bucket += 1;
+    }
+    memstat.histogram[bucket] += 1;
+    if (old && old != ptr) {
+        size_t i = (old >> 4) % MEMSTAT_CACHE;
+        size_t prev = memstat.cache[i].ptr == old ? memstat.cache[i].size : size;
+        memstat.copied += prev < size ? prev : size;
+    }
+    size_t i = (ptr >> 4) % MEMSTAT_CACHE;
+    memstat.cache[i].ptr = ptr;
+    memstat.cache[i].size = size;
+}
 
 void *malloc_assert(size_t size) {
     void *ptr = malloc(size);
     assert(ptr && "Could not malloc memory.");
+    memstat_record(MEMSTAT_MALLOC, 0, (uintptr_t)ptr, size);
     return ptr;
 }
 #define malloc malloc_assert
@@ -14,14 +85,18 @@ void *malloc_assert(size_t size) {
 void *calloc_assert(size_t nmemb, size_t size) {
     void *ptr = calloc(nmemb, size);
     assert(ptr && "Could not calloc memory.");
+    memstat_record(MEMSTAT_CALLOC, 0, (uintptr_t)ptr, nmemb * size);
     return ptr;
 }
 #define calloc calloc_assert
 
+// the source address goes through memstat, so that no copy of ptr is live after the realloc
 void *realloc_assert(void *ptr, size_t size) {
-    ptr = realloc(ptr, size);
-    assert(ptr && "Could not realloc memory.");
-    return ptr;
+    memstat.realloc_from = (uintptr_t)ptr;
+    void *new_ptr = realloc(ptr, size);
+    assert(new_ptr && "Could not realloc memory.");
+    memstat_record(MEMSTAT_REALLOC, memstat.realloc_from, (uintptr_t)new_ptr, size);
+    return new_ptr;
 }
 #define realloc realloc_assert
 
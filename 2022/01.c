@@ -17,7 +17,7 @@ CMP(long)
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/01.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/01.txt"));
 
     // add up calories of every elf, append to cals
     long *cals = calloc(1, sizeof(*cals));
@@ -17,7 +17,7 @@
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/02.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/02.txt"));
 
     // define points map for first rule set
     const long map1['Z' + 1]['Z' + 1] = {
@@ -54,7 +54,7 @@ char find_common_char_3(const char *str1, const char *str2, const char *str3) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/03.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/03.txt"));
 
     // find common char between first and second half of every line and add up priorities
     long sum_prio1 = 0;
@@ -14,7 +14,7 @@
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/04.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/04.txt"));
 
     // count how often one range is fully contained in the other
     long count1 = 0;
@@ -25,7 +25,7 @@ int all_chars_unique(const char *str, size_t n) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/06.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/06.txt"));
 
     // part 1
     const size_t n = strlen(line[0]);
@@ -23,7 +23,7 @@ CMP(size_t)
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/07.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/07.txt"));
 
     // find all directory sizes
     size_t *size_dir = 0;
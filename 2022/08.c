@@ -99,7 +99,7 @@ size_t scenic_score(const char **line, size_t ni, size_t nj, size_t i0, size_t j
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/08.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/08.txt"));
 
     // find visible trees
     const size_t ni = n_lines;
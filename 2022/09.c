@@ -42,7 +42,7 @@ void position_follow(Position *tail, const Position *head) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/09.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/09.txt"));
 
     // simulate rope with 2 and 10 knots
     const size_t nr[] = {2, 10};
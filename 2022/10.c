@@ -18,7 +18,7 @@
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/10.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/10.txt"));
 
     // simulate cathode-ray tube
     long sum_signal_strength = 0;
@@ -127,7 +127,7 @@ void solve(const char **line, size_t n_lines, size_t part) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/11.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/11.txt"));
 
     // part 1
     solve(line, n_lines, 1);
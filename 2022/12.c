@@ -74,7 +74,7 @@ const char *strchrnul(const char *s, int c) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/12.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/12.txt"));
 
     // build height profile
     const size_t ni = n_lines;
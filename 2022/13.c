@@ -168,7 +168,7 @@ int cmp_packet_asc(const void *_a, const void *_b) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/13.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/13.txt"));
 
     // create packets
     List *packet = list_alloc(sizeof(PacketData));
@@ -44,7 +44,7 @@ size_t drop_sand(char grid[NY][NX], long max_y) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/14.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/14.txt"));
 
     // create reservoir
     long max_y = LONG_MIN;
@@ -60,19 +60,31 @@ size_t solve_part_1(const List *sensor, const Dict *beacon, const long y0) {
     size_t count = 0;
     for (const Node *node = range->first; node; node = node->next) {
         const Range *r = node->data;
-        count += (r->x1 - r->x0);
+        count += (r->x1 - r->x0 + 1);
     }
 
-    // remove all position where beacons are
-    for (size_t i = 0; i < beacon->len; ++i) {
+    // remove all position where beacons are, the reduced ranges are sorted and disjoint,
+    // so index them in vector mode and binary search for the last range starting before the beacon
+    list_vectorize(range);
+    for (size_t i = 0; i < beacon->size; ++i) {
         const Item *item = &beacon->item[i];
         while (item && item->key) {
             const Point *p = item->data;
-            for (const Node *node = range->first; node; node = node->next) {
-                const Range *r = node->data;
-                if ((p->y == y0) && (r->x0 <= p->x) && (p->x <= r->x1)) {
+            if (p->y == y0) {
+                size_t lo = 0;
+                size_t hi = range->len;
+                while (lo < hi) {
+                    const size_t mid = lo + (hi - lo) / 2;
+                    const Range *r = list_get(range, mid)->data;
+                    if (r->x0 <= p->x) {
+                        lo = mid + 1;
+                    }
+                    else {
+                        hi = mid;
+                    }
+                }
+                if (lo && (p->x <= ((Range *)list_get(range, lo - 1)->data)->x1)) {
                     --count;
-                    break;
                 }
             }
             item = item->next;
@@ -134,7 +146,7 @@ size_t solve_part_2(const List *sensor, const long clip[2]) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/15.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/15.txt"));
 
     // create list of sensors and dict of beacons
     List *sensor = list_alloc(sizeof(Point));
@@ -115,7 +115,7 @@ size_t dfs(size_t n, const size_t *rate, const List *non_zero, const size_t *cos
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/16.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/16.txt"));
 
     // create map between valve name and index, read flow rates, find non-zero valves
     Dict *v2i = dict_alloc(sizeof(size_t), 2 * n_lines);
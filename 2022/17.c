@@ -151,7 +151,7 @@ size_t drop_rocks(const char *jet, const long rock[5][5][2], size_t _n) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/17.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/17.txt"));
 
     // set up jet
     const char *jet = line[0];
@@ -43,7 +43,7 @@ void flood_fill(size_t ni, size_t nj, size_t nk, int outside[ni][nj][nk], int cu
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/18.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/18.txt"));
 
     // get the maximum x-, y-, and z-coordinates
     size_t x_max = 0;
@@ -29,6 +29,7 @@ long _dfs(Blueprint *bp, long time, Miningstate s, Dict *cache, long *best) {
     if (time == 0) {
         return s.amt[GEO];
     }
+    profile_count("states expanded", 1);
 
     // check cache
     char key[256] = "";
@@ -123,10 +124,14 @@ long dfs(Blueprint *bp, long time) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/19.txt");
+    size_t n_lines = 0;
+    PROFILE("parse") {
+        n_lines = lines_read(&line, input_path("2022/input/19.txt"));
+    }
 
     // create blueprints
     Blueprint *bp = calloc(n_lines, sizeof(*bp));
+    PROFILE("parse")
     for (size_t i = 0; i < n_lines; ++i) {
         sscanf(line[i],
                "Blueprint %*d: "
@@ -145,6 +150,7 @@ int main(void) {
 
     // part 1
     long sum_quality_level = 0;
+    PROFILE("part 1")
     for (size_t i = 0; i < n_lines; ++i) {
         sum_quality_level += (i + 1) * dfs(&bp[i], 24);
     }
@@ -152,6 +158,7 @@ int main(void) {
 
     // part 2
     long prod_geo_cnt = 1;
+    PROFILE("part 2")
     for (size_t i = 0; i < MIN(n_lines, 3); ++i) {
         prod_geo_cnt *= dfs(&bp[i], 32);
     }
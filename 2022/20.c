@@ -3,8 +3,14 @@
  * (https://adventofcode.com/2022/day/20)
  *
  * Part 1:
- * - set up a circular list for the values
- * - set up an array of pointers to the nodes, so that we can move them in order
+ * - keep the numbers in a block list, short arrays of numbers in list order, and remember for
+ *   every number the block it is in
+ * - keep the block lengths in a Fenwick tree, to get the length of all blocks before a block, or
+ *   the block at a position, in O(log n)
+ * - the position of a number is the length of all blocks before its block plus its index in
+ *   the block, moving it is removing it there and inserting it at (position + value) mod (n - 1)
+ * - apart from the Fenwick tree these are short scans and memmoves over contiguous memory
+ * - when a block is full, distribute all numbers evenly again
  *
  * Part 2:
  * - multiply values before moving
@@ -12,66 +18,190 @@
  */
 #include "aoc.h"
 
-CMP(long)
+typedef struct Mixer {
+    size_t size;     // numbers per block after distribution, blocks have room for twice as many
+    size_t n_block;  // number of blocks
+    size_t top;      // largest power of two not above n_block
+    size_t *len;     // number of numbers in each block
+    size_t *tree;    // Fenwick tree of block lengths, 1-based
+    uint32_t **id;   // numbers in each block in list order
+    uint32_t *in;    // block of each number
+    uint32_t *all;   // all numbers in list order, used for distribution
+} Mixer;
 
-long solve(List *list, long mul, size_t n_mix) {
-    const size_t n = list->len;
+// add delta to the length of block b
+void mixer_add(Mixer *mixer, size_t b, long delta) {
+    mixer->len[b] += delta;
+    for (size_t i = b + 1; i <= mixer->n_block; i += i & -i) {
+        mixer->tree[i] += delta;
+    }
+}
+
+// return length of all blocks before block b
+size_t mixer_prefix(const Mixer *mixer, size_t b) {
+    size_t sum = 0;
+    for (size_t i = b; i > 0; i -= i & -i) {
+        sum += mixer->tree[i];
+    }
+    return sum;
+}
+
+// return first block that ends at or after position *k (after position *k if after is set),
+// set *k to the position in that block
+size_t mixer_find(const Mixer *mixer, size_t *k, int after) {
+    size_t b = 0;
+    for (size_t step = mixer->top; step > 0; step /= 2) {
+        if (b + step <= mixer->n_block && mixer->tree[b + step] < *k + after) {
+            b += step;
+            *k -= mixer->tree[b];
+        }
+    }
+    return b;
+}
 
-    // create array of node pointers, multiply values with decryption key
-    Node **node = calloc(n, sizeof(*node));
+// rebuild Fenwick tree from block lengths
+void mixer_tree(Mixer *mixer) {
+    for (size_t i = 1; i <= mixer->n_block; ++i) {
+        mixer->tree[i] = mixer->len[i - 1];
+    }
+    for (size_t i = 1; i <= mixer->n_block; ++i) {
+        const size_t j = i + (i & -i);
+        if (j <= mixer->n_block) {
+            mixer->tree[j] += mixer->tree[i];
+        }
+    }
+}
+
+Mixer mixer_alloc(size_t n) {
+    Mixer mixer = {.size = 64};
+    mixer.n_block = (n + mixer.size - 1) / mixer.size;
+    mixer.top = 1;
+    while (2 * mixer.top <= mixer.n_block) {
+        mixer.top *= 2;
+    }
+    mixer.len = calloc(mixer.n_block, sizeof(*mixer.len));
+    mixer.tree = calloc(mixer.n_block + 1, sizeof(*mixer.tree));
+    mixer.id = calloc(mixer.n_block, sizeof(*mixer.id));
+    for (size_t b = 0; b < mixer.n_block; ++b) {
+        mixer.id[b] = malloc(2 * mixer.size * sizeof(*mixer.id[b]));
+    }
+    mixer.in = malloc(n * sizeof(*mixer.in));
+    mixer.all = malloc(n * sizeof(*mixer.all));
+
+    // numbers start in input order
     for (size_t i = 0; i < n; ++i) {
-        node[i] = list_get(list, i);
-        *(long *)node[i]->data *= mul;
+        const size_t b = i / mixer.size;
+        mixer.id[b][mixer.len[b]++] = i;
+        mixer.in[i] = b;
+    }
+    mixer_tree(&mixer);
+    return mixer;
+}
+
+void mixer_free(Mixer *mixer) {
+    for (size_t b = 0; b < mixer->n_block; ++b) {
+        free(mixer->id[b]);
+    }
+    free(mixer->len);
+    free(mixer->tree);
+    free(mixer->id);
+    free(mixer->in);
+    free(mixer->all);
+}
+
+// distribute numbers evenly over the blocks again
+void mixer_distribute(Mixer *mixer) {
+    size_t n = 0;
+    for (size_t b = 0; b < mixer->n_block; ++b) {
+        memcpy(&mixer->all[n], mixer->id[b], mixer->len[b] * sizeof(*mixer->all));
+        n += mixer->len[b];
+    }
+    for (size_t b = 0; b < mixer->n_block; ++b) {
+        const size_t first = MIN(b * mixer->size, n);
+        mixer->len[b] = MIN(mixer->size, n - first);
+        memcpy(mixer->id[b], &mixer->all[first], mixer->len[b] * sizeof(*mixer->all));
+        for (size_t j = 0; j < mixer->len[b]; ++j) {
+            mixer->in[mixer->id[b][j]] = b;
+        }
+    }
+    mixer_tree(mixer);
+}
+
+// return position of number i
+size_t mixer_position(const Mixer *mixer, size_t i) {
+    const size_t b = mixer->in[i];
+    size_t j = 0;
+    while (mixer->id[b][j] != i) {
+        ++j;
+    }
+    return mixer_prefix(mixer, b) + j;
+}
+
+// remove number i,
+// return position it was at
+size_t mixer_remove(Mixer *mixer, size_t i) {
+    const size_t b = mixer->in[i];
+    uint32_t *id = mixer->id[b];
+    size_t j = 0;
+    while (id[j] != i) {
+        ++j;
+    }
+    const size_t pos = mixer_prefix(mixer, b) + j;
+    memmove(&id[j], &id[j + 1], (mixer->len[b] - 1 - j) * sizeof(*id));
+    mixer_add(mixer, b, -1);
+    return pos;
+}
+
+// insert number i at position k
+void mixer_insert(Mixer *mixer, size_t i, size_t k) {
+    const size_t b = mixer_find(mixer, &k, 0);
+    uint32_t *id = mixer->id[b];
+    memmove(&id[k + 1], &id[k], (mixer->len[b] - k) * sizeof(*id));
+    id[k] = i;
+    mixer->in[i] = b;
+    mixer_add(mixer, b, +1);
+    if (mixer->len[b] == 2 * mixer->size) {
+        mixer_distribute(mixer);
     }
+}
 
-    // make list circular
-    list->first->prev = list->last;
-    list->last->next = list->first;
+// return number at position k
+size_t mixer_at(const Mixer *mixer, size_t k) {
+    const size_t b = mixer_find(mixer, &k, 1);
+    return mixer->id[b][k];
+}
 
-    // get zero node
-    const Node *zero = list_find(list, &(long){0}, cmp_long_asc);
+long solve(size_t n, const long *val, long mul, size_t n_mix) {
+    // multiply values with decryption key
+    long *num = malloc(n * sizeof(*num));
+    size_t zero = n;
+    for (size_t i = 0; i < n; ++i) {
+        num[i] = val[i] * mul;
+        zero = (val[i] == 0 ? i : zero);
+    }
+    assert(zero < n);
 
-    // move nodes
-    for (size_t mix = 0; mix < n_mix; ++mix) {
+    // move numbers, in a circle of the n - 1 other numbers
+    Mixer mixer = mixer_alloc(n);
+    const long m = (long)n - 1;
+    for (size_t mix = 0; mix < n_mix && m > 0; ++mix) {
         for (size_t i = 0; i < n; ++i) {
-            Node *curr = node[i];
-            const long val = *(long *)curr->data;
-            Node *prev = curr;
-            if (val >= 0) {  // move right
-                for (size_t j = 0; j < labs(val) % (n - 1); ++j) {
-                    prev = prev->next;
-                }
-            }
-            else {  // move left
-                for (size_t j = 0; j < (labs(val) + 1) % (n - 1); ++j) {
-                    prev = prev->prev;
-                }
-            }
-            if (prev != curr) {
-                curr->prev->next = curr->next;
-                curr->next->prev = curr->prev;
-                curr->prev = prev;
-                curr->next = prev->next;
-                prev->next->prev = curr;
-                prev->next = curr;
-            }
+            const long pos = (long)mixer_remove(&mixer, i);
+            mixer_insert(&mixer, i, (size_t)(((pos + num[i] % m) % m + m) % m));
         }
     }
 
     // read code
     long sum = 0;
     const size_t offset[3] = {1000, 2000, 3000};
+    const size_t pos = mixer_position(&mixer, zero);
     for (size_t i = 0; i < 3; ++i) {
-        const Node *curr = zero;
-        for (size_t j = 0; j < offset[i] % n; ++j) {
-            curr = curr->next;
-        }
-        sum += *(long *)curr->data;
+        sum += num[mixer_at(&mixer, (pos + offset[i]) % n)];
     }
 
     // cleanup
-    list_free(&list, free);
-    free(node);
+    mixer_free(&mixer);
+    free(num);
 
     return sum;
 }
@@ -79,23 +209,21 @@ long solve(List *list, long mul, size_t n_mix) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n = lines_read(&line, "2022/input/20.txt");
+    const size_t n = lines_read(&line, input_path("2022/input/20.txt"));
 
-    // create initial list and array of pointer to the nodes
-    List *list = list_alloc(sizeof(long));
+    // read values
+    long *val = calloc(n, sizeof(*val));
     for (size_t i = 0; i < n; ++i) {
-        long val = 0;
-        sscanf(line[i], "%ld", &val);
-        list_insert_last(list, memdup(&val, sizeof(val)));
+        sscanf(line[i], "%ld", &val[i]);
     }
 
     // part 1
-    printf("%ld\n", solve(list_copy(list, memcpy), 1, 1));
+    printf("%ld\n", solve(n, val, 1, 1));
 
     // part 2
-    printf("%ld\n", solve(list_copy(list, memcpy), 811589153, 10));
+    printf("%ld\n", solve(n, val, 811589153, 10));
 
     // cleanup
     lines_free(line, n);
-    list_free(&list, free);
+    free(val);
 }
@@ -163,7 +163,7 @@ void monkey_invert(const Dict *monkey, const char *root, const char *humn) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/21.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/21.txt"));
 
     // create monkeys
     Dict *monkey = dict_alloc(sizeof(Monkeyjob), 2 * n_lines);
@@ -221,7 +221,7 @@ size_t runner_password(const Runner *runner, const Face face[6]) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/22.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/22.txt"));
 
     // determine face side length, either 4 or 50
     const size_t n = (n_lines - 2 < 6 * 4 ? 4 : 50);
@@ -145,7 +145,7 @@ size_t elf_simulate(List *elf, size_t n_round) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/23.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/23.txt"));
 
     // create elf locations
     List *elf = list_alloc(sizeof(Elf));
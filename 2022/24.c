@@ -75,7 +75,7 @@ cleanup:
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/24.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/24.txt"));
 
     // create map
     const size_t ni = n_lines - 2;
@@ -48,7 +48,7 @@ char *decimal_to_snafu(long decimal, char *snafu) {
 int main(void) {
     // read input
     const char **line = 0;
-    const size_t n_lines = lines_read(&line, "2022/input/25.txt");
+    const size_t n_lines = lines_read(&line, input_path("2022/input/25.txt"));
 
     // compute the sum of the snafu numbers
     long sum = 0;
@@ -0,0 +1 @@
+../2021/generic.h
\ No newline at end of file
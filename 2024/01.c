@@ -3,11 +3,12 @@
 void parse(List *left, List *right, const char *fname);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    const char *fname = input_path("2024/input/01.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 16));
 
     List left = list_create(&arena, sizeof(long), cmp_long);
     List right = list_create(&arena, sizeof(long), cmp_long);
-    parse(&left, &right, "2024/input/01.txt");
+    parse(&left, &right, fname);
 
     list_sort(&left, nullptr);
     list_sort(&right, nullptr);
@@ -10,10 +10,11 @@ int issafe1(const Report *report);
 int issafe2(const Report *report, Arena arena);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    const char *fname = input_path("2024/input/02.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 16));
 
     List report = list_create(&arena, sizeof(Report), nullptr);
-    parse(&report, "2024/input/02.txt", &arena);
+    parse(&report, fname, &arena);
 
     long part1 = 0;
     long part2 = 0;
@@ -1,63 +1,118 @@
 #include "aoc.h"
 
-char *parse(const char *fname, Arena *arena);
-long compute(const char *input);
-char *filter(char *input);
+constexpr long chunk = 1 << 16;
+
+typedef enum { idle, keyword, first, second } State;
+
+typedef struct {
+    State state;
+    bool enabled;
+    long matched;
+    char word[8];
+    long operand[2];
+    long digits;
+    long part1;
+    long part2;
+} Scanner;
+
+void scan(Scanner *scanner, const char *data, long size);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    FILE *file = fopen(input_path("2024/input/03.txt"), "r");
+    assert(file);
 
-    char *input = string_parse("2024/input/03.txt", "\n", &arena);
+    static char buffer[chunk];
+    Scanner scanner = {.enabled = true};
+    long size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        scan(&scanner, buffer, size);
+    }
+    fclose(file);
 
-    printf("%ld\n", compute(input));
-    printf("%ld\n", compute(filter(input)));
+    printf("%ld\n", scanner.part1);
+    printf("%ld\n", scanner.part2);
+}
 
-    arena_destroy(&arena);
+void start(Scanner *scanner, char ch) {
+    scanner->state = idle;
+    if (ch == 'm' || ch == 'd') {
+        scanner->state = keyword;
+        scanner->word[0] = ch;
+        scanner->matched = 1;
+    }
 }
 
-long compute(const char *input) {
-    long sum = 0;
-    while (true) {
-        char *begin = strstr(input, "mul(");
-        if (!begin || !strstr(begin, ")")) {
-            return sum;
+void match(Scanner *scanner, char ch) {
+    scanner->word[scanner->matched++] = ch;
+    scanner->word[scanner->matched] = 0;
+    if (!strcmp(scanner->word, "mul(")) {
+        scanner->state = first;
+        scanner->operand[0] = 0;
+        scanner->operand[1] = 0;
+        scanner->digits = 0;
+        return;
+    }
+    if (!strcmp(scanner->word, "do()") || !strcmp(scanner->word, "don't()")) {
+        scanner->enabled = scanner->matched == 4;
+        scanner->state = idle;
+        return;
+    }
+    static const char *const words[] = {"mul(", "do()", "don't()"};
+    for (size_t i = 0; i < countof(words); i++) {
+        if (!strncmp(scanner->word, words[i], scanner->matched)) {
+            return;
         }
-        char *c = begin + 4;
-        if (isdigit(*c)) {
-            while (isdigit(*c)) {
-                c++;
-            };
-            if (*c == ',' && isdigit(*(c + 1))) {
-                c += 1;
-                while (isdigit(*c)) {
-                    c++;
-                };
-                if (*c == ')') {
-                    long x;
-                    long y;
-                    sscanf(begin, "mul(%ld,%ld)", &x, &y);
-                    sum += x * y;
-                }
+    }
+    start(scanner, ch);
+}
+
+void step(Scanner *scanner, char ch) {
+    if (ch == '\n') {
+        return;
+    }
+    switch (scanner->state) {
+        case idle: start(scanner, ch); break;
+        case keyword: match(scanner, ch); break;
+        case first:
+        case second:
+            if (isdigit(ch)) {
+                long *x = &scanner->operand[scanner->state == second];
+                *x = (*x * decimal) + (ch - '0');
+                scanner->digits += 1;
             }
-        }
-        input = c;
+            else if (scanner->digits && scanner->state == first && ch == ',') {
+                scanner->state = second;
+                scanner->digits = 0;
+            }
+            else if (scanner->digits && scanner->state == second && ch == ')') {
+                long product = scanner->operand[0] * scanner->operand[1];
+                scanner->part1 += product;
+                scanner->part2 += scanner->enabled ? product : 0;
+                scanner->state = idle;
+            }
+            else {
+                start(scanner, ch);
+            }
+            break;
     }
 }
 
-char *filter(char *input) {
-    char *str = input;
-    while (true) {
-        char *begin = strstr(str, "don't()");
-        if (!begin) {
-            return input;
-        }
-        char *end = strstr(begin, "do()");
-        if (!end) {
-            return input;
-        }
-        for (auto c = begin; c < end; c++) {
-            *c = '-';
+void scan(Scanner *scanner, const char *data, long size) {
+    long next[2] = {-1, -1};
+    long i = 0;
+    while (i < size) {
+        if (scanner->state == idle) {
+            for (long k = 0; k < 2; k++) {
+                if (next[k] < i) {
+                    const char *found = memchr(data + i, "md"[k], size - i);
+                    next[k] = found ? found - data : size;
+                }
+            }
+            i = lmin(next[0], next[1]);
+            if (i == size) {
+                return;
+            }
         }
-        str = end + 4;
+        step(scanner, data[i++]);
     }
 }
@@ -1,57 +1,102 @@
 #include "aoc.h"
 
-long search1(const Grid *grid, long r, long c);
-long search2(const Grid *grid, long r, long c);
+constexpr long lanes = 64;
 
-int main(void) {
-    Arena arena = arena_create(mega_byte);
+typedef struct {
+    long rows;
+    long cols;
+    long stride;
+    char *origin;
+} Board;
 
-    Grid grid = grid_parse("2024/input/04.txt", &arena);
+Board board_create(const Grid *grid, long margin, Arena *arena);
+long search1(const Board *board, const char *word);
+long search2(const Board *board, const char *word, Arena arena);
 
-    long part1 = 0;
-    long part2 = 0;
-    for (long r = 0; r < grid.rows; r++) {
-        for (long c = 0; c < grid.cols; c++) {
-            part1 += search1(&grid, r, c);
-            part2 += search2(&grid, r, c);
-        }
-    }
-    printf("%ld\n", part1);
-    printf("%ld\n", part2);
+int main(int argc, char **argv) {
+    const char *fname = input_path("2024/input/04.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 8));
+
+    const char *word = argc > 1 ? argv[1] : "XMAS";
+    const char *cross = argc > 2 ? argv[2] : "MAS";
+    assert(strlen(cross) % 2 == 1);
+
+    Grid grid = grid_parse(fname, &arena);
+    long margin = lmax(strlen(word), strlen(cross));
+    Board board = board_create(&grid, margin, &arena);
+
+    printf("%ld\n", search1(&board, word));
+    printf("%ld\n", search2(&board, cross, arena));
 
     arena_destroy(&arena);
 }
 
-long search1(const Grid *grid, long r, long c) {
-    if (grid_get(grid, r, c) != 'X') {
-        return 0;
+Board board_create(const Grid *grid, long margin, Arena *arena) {
+    Board board = {.rows = grid->rows, .cols = grid->cols};
+    board.stride = grid->cols + (2 * margin) + lanes;
+    char *data = calloc(arena, data, (grid->rows + (2 * margin)) * board.stride);
+    board.origin = data + (margin * board.stride) + margin;
+    for (long r = 0; r < grid->rows; r++) {
+        memcpy(board.origin + (r * board.stride), grid->data + (r * grid->cols), grid->cols);
+    }
+    return board;
+}
+
+uint64_t match(const char *data, long step, const char *word) {
+    uint64_t mask = ~(uint64_t)0;
+    for (long k = 0; word[k] && mask; k++) {
+        const char *view = data + (k * step);
+        uint64_t equal = 0;
+        for (long j = 0; j < lanes; j++) {
+            equal |= (uint64_t)(view[j] == word[k]) << j;
+        }
+        mask &= equal;
     }
+    return mask;
+}
+
+uint64_t lane_mask(long cols, long c) {
+    return cols - c >= lanes ? ~(uint64_t)0 : ((uint64_t)1 << (cols - c)) - 1;
+}
+
+long search1(const Board *board, const char *word) {
     long count = 0;
-    char xmas[5] = {grid_get(grid, r, c)};
     for (long dr = -1; dr <= 1; dr++) {
         for (long dc = -1; dc <= 1; dc++) {
             if (dr == 0 && dc == 0) {
                 continue;
             }
-            for (long i = 1; i <= 3; i++) {
-                xmas[i] = grid_get(grid, r + (i * dr), c + (i * dc));
-            }
-            if (!strcmp(xmas, "XMAS")) {
-                count += 1;
+            for (long r = 0; r < board->rows; r++) {
+                for (long c = 0; c < board->cols; c += lanes) {
+                    const char *data = board->origin + (r * board->stride) + c;
+                    uint64_t mask = match(data, (dr * board->stride) + dc, word);
+                    count += popcount(mask & lane_mask(board->cols, c));
+                }
             }
         }
     }
     return count;
 }
 
-long search2(const Grid *grid, long r, long c) {
-    if (grid_get(grid, r, c) != 'A') {
-        return 0;
+long search2(const Board *board, const char *word, Arena arena) {
+    long stride = board->stride;
+    long half = strlen(word) / 2;
+    char *reverse = strdup(&arena, word);
+    for (long i = 0, j = strlen(word) - 1; i < j; i++, j--) {
+        char tmp = reverse[i];
+        reverse[i] = reverse[j];
+        reverse[j] = tmp;
     }
-    char s[5] = {};
-    s[0] = grid_get(grid, r - 1, c - 1);
-    s[1] = grid_get(grid, r - 1, c + 1);
-    s[2] = grid_get(grid, r + 1, c + 1);
-    s[3] = grid_get(grid, r + 1, c - 1);
-    return !strcmp(s, "MMSS") || !strcmp(s, "MSSM") || !strcmp(s, "SSMM") || !strcmp(s, "SMMS");
+    long count = 0;
+    for (long r = 0; r < board->rows; r++) {
+        for (long c = 0; c < board->cols; c += lanes) {
+            const char *center = board->origin + (r * stride) + c;
+            const char *down = center - (half * (stride + 1));
+            const char *up = center - (half * (stride - 1));
+            uint64_t mask = match(down, stride + 1, word) | match(down, stride + 1, reverse);
+            mask &= match(up, stride - 1, word) | match(up, stride - 1, reverse);
+            count += popcount(mask & lane_mask(board->cols, c));
+        }
+    }
+    return count;
 }
@@ -1,27 +1,56 @@
 #include "aoc.h"
 
-void parse(Dict *rule, List *update, const char *fname, Arena *arena);
-int compare(const void *_a, const void *_b, void *_rule);
-int sorted(const List *page, Dict *rule);
+constexpr long pages = 100;
+constexpr long words = (pages + 63) / 64;
+
+typedef uint64_t Pages[words];
+
+typedef struct {
+    long length;
+    long *number;
+} Update;
+
+typedef struct {
+    const Update *update;
+    long length;
+    const Pages *before;
+    long part1;
+    long part2;
+} Task;
+
+void parse(Pages *before, List *update, const char *fname, Arena *arena);
+bool sorted(const Update *update, const Pages *before);
+long middle(const Update *update, const Pages *before);
+void *check(void *arg);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    const char *fname = input_path("2024/input/05.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 8));
+
+    Pages *before = calloc(&arena, before, pages);
+    List update = list_create(&arena, sizeof(Update), nullptr);
+    parse(before, &update, fname, &arena);
+
+    Update *page = calloc(&arena, page, update.length);
+    long length = 0;
+    list_for_each(u, &update) {
+        page[length++] = *(Update *)u->data;
+    }
 
-    Dict rule = dict_create(&arena, sizeof(int));
-    List update = list_create(&arena, sizeof(List), nullptr);
-    parse(&rule, &update, "2024/input/05.txt", &arena);
+    long count = thread_count(length);
+    Task *task = calloc(&arena, task, count);
+    for (long i = 0; i < count; i++) {
+        long begin = length * i / count;
+        long end = length * (i + 1) / count;
+        task[i] = (Task){.update = page + begin, .length = end - begin, .before = before};
+    }
+    parallel_run(check, task, count, sizeof(*task));
 
     long part1 = 0;
     long part2 = 0;
-    list_for_each(u, &update) {
-        List *page = u->data;
-        if (sorted(page, &rule)) {
-            part1 += *(long *)list_get(page, page->length / 2);
-        }
-        else {
-            list_sort(page, &rule);
-            part2 += *(long *)list_get(page, page->length / 2);
-        }
+    for (long i = 0; i < count; i++) {
+        part1 += task[i].part1;
+        part2 += task[i].part2;
     }
     printf("%ld\n", part1);
     printf("%ld\n", part2);
@@ -29,7 +58,15 @@ int main(void) {
     arena_destroy(&arena);
 }
 
-void parse(Dict *rule, List *update, const char *fname, Arena *arena) {
+bool has_page(const Pages set, long page) {
+    return (set[page / 64] >> (page % 64)) & 1;
+}
+
+void add_page(Pages set, long page) {
+    set[page / 64] |= (uint64_t)1 << (page % 64);
+}
+
+void parse(Pages *before, List *update, const char *fname, Arena *arena) {
     FILE *file = fopen(fname, "r");
     assert(file);
     char line[bufsize];
@@ -40,14 +77,15 @@ void parse(Dict *rule, List *update, const char *fname, Arena *arena) {
         long a;
         long b;
         sscanf(line, "%ld|%ld", &a, &b);
-        dict_insert(rule, (long[]){a, b}, sizeof(long[2]), &(int){-1});
-        dict_insert(rule, (long[]){b, a}, sizeof(long[2]), &(int){+1});
+        assert(0 <= a && a < pages && 0 <= b && b < pages);
+        add_page(before[b], a);
     }
     while (fgets(line, sizeof(line), file)) {
-        List page = list_create(arena, sizeof(long), compare);
+        Update page = {};
         char *token = strtok(line, ",");
         while (token) {
-            list_append(&page, &(long){strtol(token, nullptr, decimal)});
+            page.number = realloc(arena, page.number, ++page.length);
+            page.number[page.length - 1] = strtol(token, nullptr, decimal);
             token = strtok(nullptr, ",");
         }
         list_append(update, &page);
@@ -55,19 +93,42 @@ void parse(Dict *rule, List *update, const char *fname, Arena *arena) {
     fclose(file);
 }
 
-int compare(const void *_a, const void *_b, void *_rule) {
-    const long *a = _a;
-    const long *b = _b;
-    const Dict *rule = _rule;
-    int *order = dict_find(rule, (long[]){*a, *b}, sizeof(long[2]));
-    return order ? *order : 0;
+bool sorted(const Update *update, const Pages *before) {
+    for (long i = 1; i < update->length; i++) {
+        if (has_page(before[update->number[i - 1]], update->number[i])) {
+            return false;
+        }
+    }
+    return true;
 }
 
-int sorted(const List *page, Dict *rule) {
-    for (auto a = page->begin, b = a->next; a && b; a = a->next, b = b->next) {
-        if (compare(a->data, b->data, rule) > 0) {
-            return 0;
+long middle(const Update *update, const Pages *before) {
+    Pages member = {};
+    for (long i = 0; i < update->length; i++) {
+        add_page(member, update->number[i]);
+    }
+    for (long i = 0; i < update->length; i++) {
+        long rank = 0;
+        for (long w = 0; w < words; w++) {
+            rank += popcount(before[update->number[i]][w] & member[w]);
+        }
+        if (rank == update->length / 2) {
+            return update->number[i];
+        }
+    }
+    return 0;
+}
+
+void *check(void *arg) {
+    Task *task = arg;
+    for (long i = 0; i < task->length; i++) {
+        const Update *page = &task->update[i];
+        if (sorted(page, task->before)) {
+            task->part1 += page->number[page->length / 2];
+        }
+        else {
+            task->part2 += middle(page, task->before);
         }
     }
-    return 1;
+    return nullptr;
 }
@@ -10,19 +10,26 @@ int walk(const Grid *grid, Dict *path, State s, const State *obstacle, Arena are
 int main(void) {
     Arena arena = arena_create(4 * mega_byte);
 
-    Grid grid = grid_parse("2024/input/06.txt", &arena);
+    Grid grid = {};
+    profile("parse") {
+        grid = grid_parse(input_path("2024/input/06.txt"), &arena);
+    }
 
     State start = {.pos = grid_find(&grid, '^'), .dir = {-1, 0}};
 
     Dict path = dict_create(&arena, sizeof(State));
-    walk(&grid, &path, start, nullptr, arena);
-    printf("%ld\n", path.length);
+    profile("part 1") {
+        walk(&grid, &path, start, nullptr, arena);
+        printf("%ld\n", path.length);
+    }
 
-    long count = 0;
-    dict_for_each(item, &path) {
-        count += walk(&grid, nullptr, *(State *)item->data, item->key.data, arena);
+    profile("part 2") {
+        long count = 0;
+        dict_for_each(item, &path) {
+            count += walk(&grid, nullptr, *(State *)item->data, item->key.data, arena);
+        }
+        printf("%ld\n", count);
     }
-    printf("%ld\n", count);
 
     arena_destroy(&arena);
 }
@@ -30,7 +37,9 @@ int main(void) {
 int walk(const Grid *grid, Dict *path, State s, const State *obstacle, Arena arena) {
     State prev = s;
     Set seen = set_create(&arena);
+    long steps = 0;
     while (grid_get(grid, s.pos.r, s.pos.c)) {
+        steps += 1;
         if (path) {
             dict_insert(path, &s.pos, sizeof(Vec2), &prev);
             prev = s;
@@ -45,8 +54,10 @@ int walk(const Grid *grid, Dict *path, State s, const State *obstacle, Arena are
         }
         s.pos = (Vec2){s.pos.r + s.dir.r, s.pos.c + s.dir.c};
         if (!path && set_find(&seen, &s, sizeof(State))) {
+            profile_count("walk steps", steps);
             return 1;
         }
     }
+    profile_count("walk steps", steps);
     return 0;
 }
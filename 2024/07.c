@@ -3,24 +3,66 @@
 typedef struct {
     long test;
     long *number;
+    long *width;
     long length;
 } Equation;
 
+typedef struct {
+    long i;
+    long res;
+} State;
+
+typedef bool (*Operator)(long res, long x, long width, long *prev);
+
+typedef struct {
+    const Equation *eqn;
+    long length;
+    const Operator *op;
+    State *stack;
+    long part1;
+    long part2;
+} Task;
+
 void parse(List *eqns, const char *fname, Arena *arena);
-long solvable(const Equation *eqn, long res, long i, int part2);
+bool add(long res, long x, long, long *prev);
+bool mul(long res, long x, long, long *prev);
+bool cat(long res, long x, long width, long *prev);
+bool solvable(const Equation *eqn, const Operator *op, long ops, State *stack);
+void *solve(void *arg);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    const char *fname = input_path("2024/input/07.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 16));
 
     List eqns = list_create(&arena, sizeof(Equation), nullptr);
-    parse(&eqns, "2024/input/07.txt", &arena);
+    parse(&eqns, fname, &arena);
+
+    Operator op[] = {add, mul, cat};
+
+    Equation *eqn = calloc(&arena, eqn, eqns.length);
+    long length = 0;
+    long longest = 0;
+    list_for_each(item, &eqns) {
+        eqn[length] = *(Equation *)item->data;
+        longest = lmax(longest, eqn[length].length);
+        length += 1;
+    }
+
+    long count = thread_count(length);
+    Task *task = calloc(&arena, task, count);
+    for (long i = 0; i < count; i++) {
+        long begin = length * i / count;
+        long end = length * (i + 1) / count;
+        task[i] = (Task){.eqn = eqn + begin, .length = end - begin, .op = op};
+        task[i].stack = calloc(&arena, task[i].stack, (longest * countof(op)) + 1);
+    }
+    parallel_run(solve, task, count, sizeof(*task));
 
     long part1 = 0;
     long part2 = 0;
-    list_for_each(item, &eqns) {
-        Equation *eqn = item->data;
-        part1 += solvable(eqn, eqn->test, eqn->length - 1, 0) ? eqn->test : 0;
-        part2 += solvable(eqn, eqn->test, eqn->length - 1, 1) ? eqn->test : 0;
+    for (long i = 0; i < count; i++) {
+        part1 += task[i].part1;
+        part2 += task[i].part2;
     }
     printf("%ld\n", part1);
     printf("%ld\n", part2);
@@ -42,21 +84,60 @@ void parse(List *eqns, const char *fname, Arena *arena) {
             eqn.number[eqn.length - 1] = strtol(token, nullptr, decimal);
             token = strtok(nullptr, " ");
         }
+        eqn.width = calloc(arena, eqn.width, eqn.length);
+        for (long i = 0; i < eqn.length; i++) {
+            eqn.width[i] = 1;
+            for (long v = eqn.number[i]; v; v /= decimal) {
+                eqn.width[i] *= decimal;
+            }
+        }
         list_append(eqns, &eqn);
     }
     fclose(file);
 }
 
-long solvable(const Equation *eqn, long res, long i, int part2) {
-    if (i == 0) {
-        return res == eqn->number[i] ? eqn->test : 0;
+bool add(long res, long x, long, long *prev) {
+    *prev = res - x;
+    return res > x;
+}
+
+bool mul(long res, long x, long, long *prev) {
+    *prev = res / x;
+    return res % x == 0;
+}
+
+bool cat(long res, long x, long width, long *prev) {
+    *prev = res / width;
+    return res % width == x;
+}
+
+void *solve(void *arg) {
+    Task *task = arg;
+    for (long i = 0; i < task->length; i++) {
+        const Equation *eqn = &task->eqn[i];
+        task->part1 += solvable(eqn, task->op, 2, task->stack) ? eqn->test : 0;
+        task->part2 += solvable(eqn, task->op, 3, task->stack) ? eqn->test : 0;
     }
-    long x = eqn->number[i];
-    long d = 1;
-    for (long v = x; v; v /= 10) {
-        d *= 10;
+    return nullptr;
+}
+
+bool solvable(const Equation *eqn, const Operator *op, long ops, State *stack) {
+    long top = 0;
+    stack[top++] = (State){eqn->length - 1, eqn->test};
+    while (top) {
+        State cur = stack[--top];
+        if (cur.i == 0) {
+            if (cur.res == eqn->number[0]) {
+                return true;
+            }
+            continue;
+        }
+        for (long k = ops - 1; k >= 0; k--) {
+            long prev;
+            if (op[k](cur.res, eqn->number[cur.i], eqn->width[cur.i], &prev)) {
+                stack[top++] = (State){cur.i - 1, prev};
+            }
+        }
     }
-    return (res > x && solvable(eqn, res - x, i - 1, part2)) ||
-           (res % x == 0 && solvable(eqn, res / x, i - 1, part2)) ||
-           (part2 && res % d == x && solvable(eqn, res / d, i - 1, part2));
+    return false;
 }
@@ -6,7 +6,7 @@ long count(const Grid *grid, const Dict *freq, long start, long stop, Arena aren
 int main(void) {
     Arena arena = arena_create(mega_byte);
 
-    Grid grid = grid_parse("2024/input/08.txt", &arena);
+    Grid grid = grid_parse(input_path("2024/input/08.txt"), &arena);
     Dict freq = freqs_find(&grid, &arena);
 
     printf("%ld\n", count(&grid, &freq, 1, 1, arena));
@@ -8,13 +8,14 @@ typedef struct {
 
 List create(const char *disk, Arena *arena);
 List rearrange1(List *before, Arena *arena);
-List rearrange2(List *before, Arena *arena);
 long checksum(const List *block);
+long rearrange2(const char *disk, Arena *arena);
 
 int main(void) {
-    Arena arena = arena_create(3 * mega_byte);
+    const char *fname = input_path("2024/input/09.txt");
+    Arena arena = arena_create(input_arena(fname, 3 * mega_byte, 192));
 
-    char *disk = string_parse("2024/input/09.txt", "\n", &arena);
+    char *disk = string_parse(fname, "\n", &arena);
 
     {
         Arena scratch = arena;
@@ -25,9 +26,7 @@ int main(void) {
 
     {
         Arena scratch = arena;
-        List before = create(disk, &scratch);
-        List after = rearrange2(&before, &scratch);
-        printf("%ld\n", checksum(&after));
+        printf("%ld\n", rearrange2(disk, &scratch));
     }
 
     arena_destroy(&arena);
@@ -86,29 +85,6 @@ List rearrange1(List *before, Arena *arena) {
     return after;
 }
 
-List rearrange2(List *before, Arena *arena) {
-    List after = list_create(arena, sizeof(Block), nullptr);
-    list_append(&after, before->begin->data);
-    for (auto b2 = prev_file(before->end); b2; b2 = prev_file(b2->prev)) {
-        Block *file = b2->data;
-        for (auto b1 = next_space(before->begin); b1; b1 = next_space(b1->next)) {
-            Block *space = b1->data;
-            if (space->offset >= file->offset) {
-                break;
-            }
-            if (space->length >= file->length) {
-                list_append(&after, &(Block){file->index, space->offset, file->length});
-                space->length -= file->length;
-                space->offset += file->length;
-                goto next_file;
-            }
-        }
-        list_append(&after, file);
-    next_file:;
-    }
-    return after;
-}
-
 long checksum(const List *block) {
     long sum = 0;
     for (auto b = block->begin; b; b = b->next) {
@@ -119,3 +95,55 @@ long checksum(const List *block) {
     }
     return sum;
 }
+
+long leftmost_space(const char *tree, long size, long length) {
+    if (tree[1] < length) {
+        return -1;
+    }
+    long node = 1;
+    while (node < size) {
+        node = tree[2 * node] >= length ? 2 * node : (2 * node) + 1;
+    }
+    return node - size;
+}
+
+void shrink_space(char *tree, long size, long space, long length) {
+    long node = size + space;
+    tree[node] -= length;
+    for (node /= 2; node; node /= 2) {
+        tree[node] = lmax(tree[2 * node], tree[(2 * node) + 1]);
+    }
+}
+
+long rearrange2(const char *disk, Arena *arena) {
+    long n = strlen(disk);
+    long *offset = calloc(arena, offset, n + 1);
+    for (long i = 0; i < n; i++) {
+        offset[i + 1] = offset[i] + (disk[i] - '0');
+    }
+    long spaces = n / 2;
+    long size = 1;
+    while (size < spaces) {
+        size *= 2;
+    }
+    char *tree = calloc(arena, tree, 2 * size);
+    for (long i = 0; i < spaces; i++) {
+        tree[size + i] = disk[(2 * i) + 1] - '0';
+    }
+    for (long node = size - 1; node > 0; node--) {
+        tree[node] = lmax(tree[2 * node], tree[(2 * node) + 1]);
+    }
+    long sum = 0;
+    for (long index = (n - 1) / 2; index >= 0; index--) {
+        long length = disk[2 * index] - '0';
+        long pos = offset[2 * index];
+        long space = leftmost_space(tree, size, length);
+        if (length > 0 && space >= 0 && space < index) {
+            pos = offset[(2 * space) + 1];
+            offset[(2 * space) + 1] += length;
+            shrink_space(tree, size, space, length);
+        }
+        sum += index * ((length * pos) + (length * (length - 1) / 2));
+    }
+    return sum;
+}
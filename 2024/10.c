@@ -1,21 +1,62 @@
 #include "aoc.h"
 
-long score(const Grid *grid, long r, long c, int all, Arena arena);
+constexpr long span = 256;
+constexpr long width = span + (2 * decimal);
+
+typedef struct {
+    long length;
+    long *cell;
+    long start[decimal + 1];
+} Layers;
+
+typedef struct {
+    const Grid *grid;
+    const Layers *layers;
+    const long *block;
+    long blocks;
+    uint64_t *reach;
+    long *paths;
+    pthread_barrier_t *barrier;
+    long index;
+    long count;
+    long score;
+    long rating;
+} Worker;
+
+Layers layers_create(const Grid *grid, Arena *arena);
+long blocks_create(const Grid *grid, const Layers *layers, long *block);
+void *score(void *arg);
+void *rating(void *arg);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    const char *fname = input_path("2024/input/10.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 32));
 
-    Grid grid = grid_parse("2024/input/10.txt", &arena);
+    Grid grid = grid_parse(fname, &arena);
+    Layers layers = layers_create(&grid, &arena);
+
+    long *block = calloc(&arena, block, layers.start[1] + 1);
+    long blocks = blocks_create(&grid, &layers, block);
+
+    long count = thread_count(layers.length);
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, nullptr, count);
+    long *paths = calloc(&arena, paths, grid.rows * grid.cols);
+    Worker *worker = calloc(&arena, worker, count);
+    for (long i = 0; i < count; i++) {
+        worker[i] = (Worker){.grid = &grid, .layers = &layers, .block = block, .blocks = blocks,
+                             .paths = paths, .barrier = &barrier, .index = i, .count = count};
+        worker[i].reach = calloc(&arena, worker[i].reach, ((2 * decimal) + 1) * width);
+    }
+    parallel_run(score, worker, count, sizeof(*worker));
+    parallel_run(rating, worker, count, sizeof(*worker));
+    pthread_barrier_destroy(&barrier);
 
     long part1 = 0;
     long part2 = 0;
-    for (long r = 0; r < grid.rows; r++) {
-        for (long c = 0; c < grid.cols; c++) {
-            if (grid_get(&grid, r, c) == '0') {
-                part1 += score(&grid, r, c, 0, arena);
-                part2 += score(&grid, r, c, 1, arena);
-            }
-        }
+    for (long i = 0; i < count; i++) {
+        part1 += worker[i].score;
+        part2 += worker[i].rating;
     }
     printf("%ld\n", part1);
     printf("%ld\n", part2);
@@ -23,27 +64,150 @@ int main(void) {
     arena_destroy(&arena);
 }
 
-long score(const Grid *grid, long r, long c, int all, Arena arena) {
+Layers layers_create(const Grid *grid, Arena *arena) {
+    long count[decimal + 1] = {};
+    for (long i = 0; i < grid->rows * grid->cols; i++) {
+        if (isdigit(grid->data[i])) {
+            count['9' - grid->data[i] + 1] += 1;
+        }
+    }
+    for (long h = 1; h <= decimal; h++) {
+        count[h] += count[h - 1];
+    }
+    Layers layers = {.length = count[decimal]};
+    memcpy(layers.start, count, sizeof(count));
+    layers.cell = calloc(arena, layers.cell, layers.length);
+    for (long i = 0; i < grid->rows * grid->cols; i++) {
+        if (isdigit(grid->data[i])) {
+            layers.cell[count['9' - grid->data[i]]++] = i;
+        }
+    }
+    return layers;
+}
+
+long neighbors(const Grid *grid, long i, long *next) {
+    long r = i / grid->cols;
+    long c = i % grid->cols;
     long count = 0;
-    List queue = list_create(&arena, sizeof(Vec2), nullptr);
-    Set seen = set_create(&arena);
-    list_append(&queue, &(Vec2){r, c});
-    set_insert(&seen, &(Vec2){r, c}, sizeof(Vec2));
-    while (queue.length) {
-        Vec2 *curr = list_pop(&queue, 0);
-        if (grid_get(grid, curr->r, curr->c) == '9') {
-            count += 1;
-            continue;
-        }
-        array_for_each(Vec2, d, {-1, 0}, {+1, 0}, {0, -1}, {0, +1}) {
-            Vec2 next = {curr->r + d->r, curr->c + d->c};
-            if (grid_get(grid, next.r, next.c) - grid_get(grid, curr->r, curr->c) != 1) {
+    array_for_each(Vec2, d, {-1, 0}, {+1, 0}, {0, -1}, {0, +1}) {
+        if (grid_get(grid, r + d->r, c + d->c) - grid->data[i] == 1) {
+            next[count++] = i + (d->r * grid->cols) + d->c;
+        }
+    }
+    return count;
+}
+
+long lower_bound(const Layers *layers, long layer, long index) {
+    long lo = layers->start[layer];
+    long hi = layers->start[layer + 1];
+    while (lo < hi) {
+        long mid = (lo + hi) / 2;
+        if (layers->cell[mid] < index) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+long blocks_create(const Grid *grid, const Layers *layers, long *block) {
+    long blocks = 0;
+    for (long j = 0; j < layers->start[1]; j++) {
+        long i = layers->cell[j];
+        long first = blocks ? layers->cell[block[blocks - 1]] : -span;
+        if (i - first >= span || i / grid->cols != first / grid->cols ||
+            j - block[blocks - 1] == 64) {
+            block[blocks++] = j;
+        }
+    }
+    block[blocks] = layers->start[1];
+    return blocks;
+}
+
+long share(const Worker *worker, long begin, long end, long *last) {
+    *last = begin + ((end - begin) * (worker->index + 1) / worker->count);
+    return begin + ((end - begin) * worker->index / worker->count);
+}
+
+long sweep(const Grid *grid, const Layers *layers, long begin, long end, uint64_t *reach,
+           bool clear) {
+    const long *summit = layers->cell;
+    long row = summit[begin] / grid->cols;
+    long lo = summit[begin] % grid->cols;
+    long hi = summit[end - 1] % grid->cols;
+    long offset = ((row - decimal) * width) + lo - decimal;
+    for (long j = begin; j < end; j++) {
+        reach[(row * width) + (summit[j] % grid->cols) - offset] =
+            clear ? 0 : (uint64_t)1 << (j - begin);
+    }
+    long score = 0;
+    for (long layer = 1; layer < decimal; layer++) {
+        long c0 = lmax(lo - layer, 0);
+        long c1 = lmin(hi + layer, grid->cols - 1);
+        for (long r = lmax(row - layer, 0); r <= lmin(row + layer, grid->rows - 1); r++) {
+            long first = lower_bound(layers, layer, (r * grid->cols) + c0);
+            long last = lower_bound(layers, layer, (r * grid->cols) + c1 + 1);
+            for (long j = first; j < last; j++) {
+                long i = layers->cell[j];
+                uint64_t *cell = &reach[(r * width) + (i % grid->cols) - offset];
+                if (clear) {
+                    *cell = 0;
+                    continue;
+                }
+                long next[4];
+                long n = neighbors(grid, i, next);
+                *cell = 0;
+                for (long k = 0; k < n; k++) {
+                    long nr = next[k] / grid->cols;
+                    *cell |= reach[(nr * width) + (next[k] % grid->cols) - offset];
+                }
+                if (layer == decimal - 1) {
+                    score += popcount(*cell);
+                }
+            }
+        }
+    }
+    return score;
+}
+
+void *score(void *arg) {
+    Worker *worker = arg;
+    long last;
+    for (long k = share(worker, 0, worker->blocks, &last); k < last; k++) {
+        long begin = worker->block[k];
+        long end = worker->block[k + 1];
+        worker->score += sweep(worker->grid, worker->layers, begin, end, worker->reach, false);
+        sweep(worker->grid, worker->layers, begin, end, worker->reach, true);
+    }
+    return nullptr;
+}
+
+void *rating(void *arg) {
+    Worker *worker = arg;
+    const Grid *grid = worker->grid;
+    const Layers *layers = worker->layers;
+    long *paths = worker->paths;
+    for (long layer = 0; layer < decimal; layer++) {
+        long last;
+        for (long j = share(worker, layers->start[layer], layers->start[layer + 1], &last);
+             j < last; j++) {
+            long i = layers->cell[j];
+            if (layer == 0) {
+                paths[i] = 1;
                 continue;
             }
-            if (all || set_insert(&seen, &next, sizeof(Vec2))) {
-                list_append(&queue, &next);
+            long next[4];
+            long n = neighbors(grid, i, next);
+            for (long k = 0; k < n; k++) {
+                paths[i] += paths[next[k]];
+            }
+            if (layer == decimal - 1) {
+                worker->rating += paths[i];
             }
         }
+        pthread_barrier_wait(worker->barrier);
     }
-    return count;
+    return nullptr;
 }
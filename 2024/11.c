@@ -5,7 +5,7 @@ long blink(long stone, long steps, Arena *arena);
 int main(void) {
     Arena arena = arena_create(16 * mega_byte);
 
-    char *stones = string_parse("2024/input/11.txt", "\n", &arena);
+    char *stones = string_parse(input_path("2024/input/11.txt"), "\n", &arena);
 
     long part1 = 0;
     long part2 = 0;
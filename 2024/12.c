@@ -1,22 +1,56 @@
 #include "aoc.h"
 
-void create(List *regions, const Grid *grid, Arena *arena);
-long price1(const Set *region, const Grid *grid);
-long price2(const Set *region);
+typedef struct {
+    long area;
+    long perimeter;
+    long corners;
+} Region;
+
+typedef struct {
+    long *parent;
+    Region *region;
+    const Grid *grid;
+    long begin;
+    long end;
+    char *window;
+} Band;
+
+void *label(void *arg);
+void unite(long *parent, Region *region, long a, long b);
 
 int main(void) {
-    Arena arena = arena_create(8 * mega_byte);
+    const char *fname = input_path("2024/input/12.txt");
+    Arena arena = arena_create(input_arena(fname, 2 * mega_byte, 64));
 
-    Grid grid = grid_parse("2024/input/12.txt", &arena);
+    Grid grid = grid_parse(fname, &arena);
 
-    List regions = list_create(&arena, sizeof(Set), nullptr);
-    create(&regions, &grid, &arena);
+    long *parent = calloc(&arena, parent, grid.rows * grid.cols);
+    Region *region = calloc(&arena, region, grid.rows * grid.cols);
+    long count = thread_count(grid.rows);
+    Band *band = calloc(&arena, band, count);
+    for (long i = 0; i < count; i++) {
+        long begin = grid.rows * i / count;
+        long end = grid.rows * (i + 1) / count;
+        char *window = calloc(&arena, window, 3 * (grid.cols + 2));
+        band[i] = (Band){parent, region, &grid, begin, end, window};
+    }
+    parallel_run(label, band, count, sizeof(*band));
+    for (long i = 1; i < count; i++) {
+        for (long c = 0; c < grid.cols; c++) {
+            long j = (band[i].begin * grid.cols) + c;
+            if (grid.data[j - grid.cols] == grid.data[j]) {
+                unite(parent, region, j - grid.cols, j);
+            }
+        }
+    }
 
     long part1 = 0;
     long part2 = 0;
-    list_for_each(region, &regions) {
-        part1 += price1(region->data, &grid);
-        part2 += price2(region->data);
+    for (long i = 0; i < grid.rows * grid.cols; i++) {
+        if (parent[i] == i) {
+            part1 += region[i].area * region[i].perimeter;
+            part2 += region[i].area * region[i].corners;
+        }
     }
     printf("%ld\n", part1);
     printf("%ld\n", part2);
@@ -24,67 +58,83 @@ int main(void) {
     arena_destroy(&arena);
 }
 
-void create(List *regions, const Grid *grid, Arena *arena) {
-    Set seen = set_create(arena);
-    for (long r = 0; r < grid->rows; r++) {
-        for (long c = 0; c < grid->cols; c++) {
-            if (!set_insert(&seen, &(Vec2){r, c}, sizeof(Vec2))) {
-                continue;
-            }
-            char plant = grid_get(grid, r, c);
-            Set region = set_create(arena);
-            List queue = list_create(arena, sizeof(Vec2), nullptr);
-            list_append(&queue, &(Vec2){r, c});
-            while (queue.length) {
-                Vec2 *cur = list_pop(&queue, 0);
-                if (!set_insert(&region, cur, sizeof(Vec2))) {
-                    continue;
-                }
-                set_insert(&seen, cur, sizeof(Vec2));
-                array_for_each(Vec2, dir, {-1, 0}, {+1, 0}, {0, -1}, {0, +1}) {
-                    Vec2 next = {cur->r + dir->r, cur->c + dir->c};
-                    if (grid_get(grid, next.r, next.c) == plant) {
-                        list_append(&queue, &next);
-                    }
-                }
-            }
-            list_append(regions, &region);
-        }
+long find(long *parent, long i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
     }
+    return i;
 }
 
-long price1(const Set *region, const Grid *grid) {
-    long perimeter = 0;
-    set_for_each(r2, region) {
-        Vec2 *cur = r2->key.data;
-        array_for_each(Vec2, dir, {-1, 0}, {+1, 0}, {0, -1}, {0, +1}) {
-            Vec2 next = {cur->r + dir->r, cur->c + dir->c};
-            if (grid_get(grid, next.r, next.c) != grid_get(grid, cur->r, cur->c)) {
-                perimeter += 1;
-            }
-        }
+void unite(long *parent, Region *region, long a, long b) {
+    a = find(parent, a);
+    b = find(parent, b);
+    if (a == b) {
+        return;
     }
-    return region->length * perimeter;
+    parent[b] = a;
+    region[a].area += region[b].area;
+    region[a].perimeter += region[b].perimeter;
+    region[a].corners += region[b].corners;
+}
+
+long corner(bool row, bool col, bool diagonal) {
+    return (!row && !col) + (row && col && !diagonal);
 }
 
-long price2(const Set *region) {
-    long corners = 0;
-    set_for_each(r2, region) {
-        Vec2 *cur = r2->key.data;
-        array_for_each(Vec2, dir, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}) {
-            Vec2 next_in_row = {cur->r + dir->r, cur->c};
-            Vec2 next_in_col = {cur->r, cur->c + dir->c};
-            Vec2 next_diagonal = {cur->r + dir->r, cur->c + dir->c};
-            if (!set_find(region, &next_in_row, sizeof(Vec2)) &&
-                !set_find(region, &next_in_col, sizeof(Vec2))) {
-                corners += 1;
+void *label(void *arg) {
+    Band *band = arg;
+    long *parent = band->parent;
+    Region *region = band->region;
+    const Grid *grid = band->grid;
+    long cols = grid->cols;
+    long stride = cols + 2;
+    char *window[3] = {band->window, band->window + stride, band->window + (2 * stride)};
+    if (band->begin == band->end) {
+        return nullptr;
+    }
+    if (band->begin > 0) {
+        memcpy(window[1] + 1, grid->data + ((band->begin - 1) * cols), cols);
+    }
+    memcpy(window[2] + 1, grid->data + (band->begin * cols), cols);
+    for (long r = band->begin; r < band->end; r++) {
+        char *spare = window[0];
+        window[0] = window[1];
+        window[1] = window[2];
+        window[2] = spare;
+        if (r + 1 < grid->rows) {
+            memcpy(window[2] + 1, grid->data + ((r + 1) * cols), cols);
+        }
+        else {
+            memset(window[2] + 1, 0, cols);
+        }
+        const char *above = window[0] + 1;
+        const char *here = window[1] + 1;
+        const char *below = window[2] + 1;
+        for (long c = 0; c < cols; c++) {
+            long i = (r * cols) + c;
+            char plant = here[c];
+            bool n = above[c] == plant;
+            bool s = below[c] == plant;
+            bool w = here[c - 1] == plant;
+            bool e = here[c + 1] == plant;
+            parent[i] = i;
+            if (w) {
+                unite(parent, region, i - 1, i);
             }
-            if (set_find(region, &next_in_row, sizeof(Vec2)) &&
-                set_find(region, &next_in_col, sizeof(Vec2)) &&
-                !set_find(region, &next_diagonal, sizeof(Vec2))) {
-                corners += 1;
+            if (r > band->begin && n) {
+                unite(parent, region, i - cols, i);
             }
+            Region cell = {.area = 1, .perimeter = 4 - n - s - w - e};
+            cell.corners += corner(n, e, above[c + 1] == plant);
+            cell.corners += corner(n, w, above[c - 1] == plant);
+            cell.corners += corner(s, e, below[c + 1] == plant);
+            cell.corners += corner(s, w, below[c - 1] == plant);
+            Region *root = &region[find(parent, i)];
+            root->area += cell.area;
+            root->perimeter += cell.perimeter;
+            root->corners += cell.corners;
         }
     }
-    return region->length * corners;
+    return nullptr;
 }
@@ -13,7 +13,7 @@ int main(void) {
     Arena arena = arena_create(mega_byte);
 
     List claws = list_create(&arena, sizeof(Claw), nullptr);
-    parse(&claws, "2024/input/13.txt");
+    parse(&claws, input_path("2024/input/13.txt"));
 
     long part1 = 0;
     long part2 = 0;
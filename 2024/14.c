@@ -1,40 +1,55 @@
 #include "aoc.h"
 
+constexpr long alignment = 64;
+
 typedef struct {
     Vec2 p;
     Vec2 v;
 } Robot;
 
-void parse(List *robots, const char *fname);
-Vec2 position(const Robot *robot, long cols, long rows, long time);
-long quadrant(Vec2 p, long cols, long rows);
-long safety(const List *robots, long cols, long rows, long time);
+typedef struct {
+    long length;
+    int32_t *px;
+    int32_t *py;
+    int32_t *vx;
+    int32_t *vy;
+} Swarm;
 
-int main(void) {
-    Arena arena = arena_create(mega_byte);
+void parse(List *robots, const char *fname);
+Swarm swarm_create(const List *robots, long cols, long rows, long time, Arena *arena);
+void swarm_step(Swarm *swarm, long cols, long rows);
+unsigned _BitInt(128) safety(const Swarm *swarm, long cols, long rows);
+long structure(const Swarm *swarm, long cols, long rows, Arena arena);
+long crt(long a, long m, long b, long n);
 
-    List robots = list_create(&arena, sizeof(Robot), nullptr);
-    parse(&robots, "2024/input/14.txt");
+int main(int argc, char **argv) {
+    long cols = argc > 1 ? strtol(argv[1], nullptr, decimal) : 101;
+    long rows = argc > 2 ? strtol(argv[2], nullptr, decimal) : 103;
+    assert(cols > 0 && rows > 0);
 
-    long cols = 101;
-    long rows = 103;
+    const char *fname = input_path("2024/input/14.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 16) + (cols * rows));
 
-    printf("%ld\n", safety(&robots, cols, rows, 100));
+    List robots = list_create(&arena, sizeof(Robot), nullptr);
+    parse(&robots, fname);
 
-    long part2[2] = {LONG_MAX, 0};
-    for (long time = 1; time <= rows * cols; time++) {
-        long factor = safety(&robots, cols, rows, time);
-        if (factor < part2[0]) {
-            part2[0] = factor;
-            part2[1] = time;
-        }
+    Swarm swarm = swarm_create(&robots, cols, rows, 0, &arena);
+    long part2 = structure(&swarm, cols, rows, arena);
+    for (long time = 0; time < 100; time++) {
+        swarm_step(&swarm, cols, rows);
+    }
+    print_u128(safety(&swarm, cols, rows));
+    if (part2 < 0) {
+        printf("no solution\n");
+        arena_destroy(&arena);
+        return 0;
     }
-    printf("%ld\n", part2[1]);
+    printf("%ld\n", part2);
 
+    Swarm tree = swarm_create(&robots, cols, rows, part2, &arena);
     Grid grid = grid_create(rows, cols, 0, &arena);
-    list_for_each(item, &robots) {
-        Vec2 p = position(item->data, cols, rows, part2[1]);
-        grid_set(&grid, p.r, p.c, -1);
+    for (long i = 0; i < tree.length; i++) {
+        grid_set(&grid, tree.py[i], tree.px[i], -1);
     }
     grid_write(&grid, "2024/14");
 
@@ -53,34 +68,100 @@ void parse(List *robots, const char *fname) {
     fclose(file);
 }
 
-Vec2 position(const Robot *robot, long cols, long rows, long time) {
-    Vec2 p = robot->p;
-    p.r = lmod(p.r + (time * robot->v.r), rows);
-    p.c = lmod(p.c + (time * robot->v.c), cols);
-    return p;
+Swarm swarm_create(const List *robots, long cols, long rows, long time, Arena *arena) {
+    Swarm swarm = {.length = robots->length};
+    swarm.px = calloc_aligned(arena, swarm.px, swarm.length, alignment);
+    swarm.py = calloc_aligned(arena, swarm.py, swarm.length, alignment);
+    swarm.vx = calloc_aligned(arena, swarm.vx, swarm.length, alignment);
+    swarm.vy = calloc_aligned(arena, swarm.vy, swarm.length, alignment);
+    long i = 0;
+    list_for_each(item, robots) {
+        Robot *robot = item->data;
+        swarm.vx[i] = lmod(robot->v.c, cols);
+        swarm.vy[i] = lmod(robot->v.r, rows);
+        swarm.px[i] = lmod(robot->p.c + (time * swarm.vx[i]), cols);
+        swarm.py[i] = lmod(robot->p.r + (time * swarm.vy[i]), rows);
+        i += 1;
+    }
+    return swarm;
+}
+
+void swarm_step(Swarm *swarm, long cols, long rows) {
+    int32_t *restrict px = swarm->px;
+    int32_t *restrict py = swarm->py;
+    const int32_t *restrict vx = swarm->vx;
+    const int32_t *restrict vy = swarm->vy;
+    for (long i = 0; i < swarm->length; i++) {
+        int32_t x = px[i] + vx[i];
+        int32_t y = py[i] + vy[i];
+        px[i] = x >= cols ? x - cols : x;
+        py[i] = y >= rows ? y - rows : y;
+    }
 }
 
-long quadrant(Vec2 p, long cols, long rows) {
-    if (p.r < rows / 2 && p.c < cols / 2) {
-        return 1;
+unsigned _BitInt(128) safety(const Swarm *swarm, long cols, long rows) {
+    long safety[4] = {};
+    for (long i = 0; i < swarm->length; i++) {
+        long x = swarm->px[i];
+        long y = swarm->py[i];
+        if (x != cols / 2 && y != rows / 2) {
+            safety[(2 * (x > cols / 2)) + (y > rows / 2)] += 1;
+        }
     }
-    if (p.r > rows / 2 && p.c < cols / 2) {
-        return 2;
+    return (unsigned _BitInt(128))safety[0] * safety[1] * safety[2] * safety[3];
+}
+
+double variance(const int32_t *pos, long length) {
+    long sum = 0;
+    long sum2 = 0;
+    for (long i = 0; i < length; i++) {
+        sum += pos[i];
+        sum2 += (long)pos[i] * pos[i];
     }
-    if (p.r < rows / 2 && p.c > cols / 2) {
-        return 3;
+    double mean = (double)sum / length;
+    return ((double)sum2 / length) - (mean * mean);
+}
+
+long structure(const Swarm *swarm, long cols, long rows, Arena arena) {
+    Swarm cur = *swarm;
+    cur.px = memdup_aligned(&arena, swarm->px, swarm->length, alignment);
+    cur.py = memdup_aligned(&arena, swarm->py, swarm->length, alignment);
+    double best[2] = {INFINITY, INFINITY};
+    long time[2] = {};
+    for (long t = 0; t < lmax(cols, rows); t++) {
+        double var[2] = {variance(cur.px, cur.length), variance(cur.py, cur.length)};
+        for (long k = 0; k < 2; k++) {
+            if (t < (k ? rows : cols) && var[k] < best[k]) {
+                best[k] = var[k];
+                time[k] = t;
+            }
+        }
+        swarm_step(&cur, cols, rows);
     }
-    if (p.r > rows / 2 && p.c > cols / 2) {
-        return 4;
+    return crt(time[0], cols, time[1], rows);
+}
+
+long egcd(long a, long b, long *x, long *y) {
+    if (b == 0) {
+        *x = 1;
+        *y = 0;
+        return a;
     }
-    return 0;
+    long x1;
+    long y1;
+    long g = egcd(b, a % b, &x1, &y1);
+    *x = y1;
+    *y = x1 - ((a / b) * y1);
+    return g;
 }
 
-long safety(const List *robots, long cols, long rows, long time) {
-    long safety[5] = {};
-    list_for_each(item, robots) {
-        Vec2 p = position(item->data, cols, rows, time);
-        safety[quadrant(p, cols, rows)] += 1;
+long crt(long a, long m, long b, long n) {
+    long p;
+    long q;
+    long g = egcd(m, n, &p, &q);
+    if ((b - a) % g != 0) {
+        return -1;
     }
-    return safety[1] * safety[2] * safety[3] * safety[4];
+    long k = lmod(((b - a) / g) % (n / g) * p, n / g);
+    return lmod(a + (m * k), m / g * n);
 }
@@ -7,25 +7,41 @@ static const Vec2 direction[] = {
     ['<'] = {0, -1},
 };
 
+typedef struct {
+    Grid grid;
+    Vec2 robot;
+    long *frontier;
+    uint32_t *stamp;
+    uint32_t generation;
+} Warehouse;
+
 char *parse(const char *fname, Arena *arena);
 Grid expand(const Grid *grid, Arena *arena);
-void check_move(Grid *grid, long move, Arena arena);
+Warehouse warehouse_create(Grid grid, Arena *arena);
+void push(Warehouse *house, long move);
+double run(Warehouse *narrow, Warehouse *wide, const char *moves);
 long sum(const Grid *grid);
 
-int main(void) {
-    Arena arena = arena_create(mega_byte);
+int main(int argc, char **argv) {
+    const char *fname = input_path("2024/input/15.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 48));
 
-    char *fname = "2024/input/15.txt";
     Grid grid = grid_parse(fname, &arena);
-    Grid wide = expand(&grid, &arena);
+    Warehouse wide = warehouse_create(expand(&grid, &arena), &arena);
+    Warehouse narrow = warehouse_create(grid, &arena);
     char *moves = parse(fname, &arena);
 
-    for (auto move = moves; *move; move++) {
-        check_move(&grid, *move, arena);
-        check_move(&wide, *move, arena);
+    long repeat = argc > 1 ? strtol(argv[1], nullptr, decimal) : 1;
+    double seconds = run(&narrow, &wide, moves);
+    printf("%ld\n", sum(&narrow.grid));
+    printf("%ld\n", sum(&wide.grid));
+
+    if (repeat > 1) {
+        for (long i = 1; i < repeat; i++) {
+            seconds += run(&narrow, &wide, moves);
+        }
+        fprintf(stderr, "%.3g moves/s\n", 2.0 * repeat * strlen(moves) / seconds);
     }
-    printf("%ld\n", sum(&grid));
-    printf("%ld\n", sum(&wide));
 
     arena_destroy(&arena);
 }
@@ -39,17 +55,14 @@ char *parse(const char *fname, Arena *arena) {
             break;
         }
     }
-    char *moves = calloc(arena, moves, 1);
-    long n = 1;
+    char *moves = calloc(arena, moves, input_size(fname) + 1);
+    long n = 0;
     int c;
     while ((c = fgetc(file)) != EOF) {
-        if (strchr("\n", c)) {
-            continue;
+        if (c != '\n') {
+            moves[n++] = (char)c;
         }
-        moves = realloc(arena, moves, ++n);
-        moves[n - 2] = c;
     }
-    moves[n - 1] = 0;
     fclose(file);
     return moves;
 }
@@ -75,41 +88,89 @@ Grid expand(const Grid *grid, Arena *arena) {
     return wide;
 }
 
-void make_move(Grid *grid, SetItem *item, const Vec2 *dir) {
-    if (item->next) {
-        make_move(grid, item->next, dir);
+Warehouse warehouse_create(Grid grid, Arena *arena) {
+    Warehouse house = {.grid = grid, .robot = grid_find(&grid, '@')};
+    house.frontier = calloc(arena, house.frontier, grid.rows * grid.cols);
+    house.stamp = calloc(arena, house.stamp, grid.rows * grid.cols);
+    return house;
+}
+
+bool push_horizontal(Warehouse *house, long dc) {
+    char *row = house->grid.data + (house->robot.r * house->grid.cols);
+    long c = house->robot.c + dc;
+    while (row[c] != '.' && row[c] != '#') {
+        c += dc;
     }
-    Vec2 *pos = item->key.data;
-    assert(grid_get(grid, pos->r + dir->r, pos->c + dir->c) == '.');
-    char chr = grid_set(grid, pos->r, pos->c, '.');
-    grid_set(grid, pos->r + dir->r, pos->c + dir->c, chr);
+    if (row[c] == '#') {
+        return false;
+    }
+    if (dc > 0) {
+        memmove(row + house->robot.c + 1, row + house->robot.c, c - house->robot.c);
+    }
+    else {
+        memmove(row + c, row + c + 1, house->robot.c - c);
+    }
+    row[house->robot.c] = '.';
+    return true;
 }
 
-void check_move(Grid *grid, long move, Arena arena) {
-    Vec2 dir = direction[move];
-    Vec2 pos = grid_find(grid, '@');
-    Set check = set_create(&arena);
-    set_insert(&check, &pos, sizeof(Vec2));
-    set_for_each(item, &check) {
-        Vec2 *cur = item->key.data;
-        switch (grid_get(grid, cur->r + dir.r, cur->c + dir.c)) {
+bool push_vertical(Warehouse *house, long dr) {
+    char *data = house->grid.data;
+    long offset = dr * house->grid.cols;
+    if (++house->generation == 0) {
+        memset(house->stamp, 0, sizeof(*house->stamp) * house->grid.rows * house->grid.cols);
+        house->generation = 1;
+    }
+    long length = 0;
+    house->frontier[length++] = (house->robot.r * house->grid.cols) + house->robot.c;
+    for (long i = 0; i < length; i++) {
+        long next = house->frontier[i] + offset;
+        long add[2] = {};
+        long count = 0;
+        switch (data[next]) {
             case '.': break;
-            case 'O':
-                set_insert(&check, &(Vec2){cur->r + dir.r, cur->c + dir.c}, sizeof(Vec2));
-                break;
+            case 'O': add[count++] = next; break;
             case '[':
-                set_insert(&check, &(Vec2){cur->r + dir.r, cur->c + dir.c}, sizeof(Vec2));
-                set_insert(&check, &(Vec2){cur->r + dir.r, cur->c + dir.c + 1}, sizeof(Vec2));
+                add[count++] = next;
+                add[count++] = next + 1;
                 break;
             case ']':
-                set_insert(&check, &(Vec2){cur->r + dir.r, cur->c + dir.c}, sizeof(Vec2));
-                set_insert(&check, &(Vec2){cur->r + dir.r, cur->c + dir.c - 1}, sizeof(Vec2));
+                add[count++] = next;
+                add[count++] = next - 1;
                 break;
-            case '#': return;
+            case '#': return false;
             default: abort();
         }
+        for (long k = 0; k < count; k++) {
+            if (house->stamp[add[k]] != house->generation) {
+                house->stamp[add[k]] = house->generation;
+                house->frontier[length++] = add[k];
+            }
+        }
+    }
+    while (length--) {
+        long cell = house->frontier[length];
+        data[cell + offset] = data[cell];
+        data[cell] = '.';
+    }
+    return true;
+}
+
+void push(Warehouse *house, long move) {
+    Vec2 dir = direction[move];
+    bool moved = dir.r ? push_vertical(house, dir.r) : push_horizontal(house, dir.c);
+    if (moved) {
+        house->robot = (Vec2){house->robot.r + dir.r, house->robot.c + dir.c};
+    }
+}
+
+double run(Warehouse *narrow, Warehouse *wide, const char *moves) {
+    double start = profile_clock();
+    for (auto move = moves; *move; move++) {
+        push(narrow, *move);
+        push(wide, *move);
     }
-    make_move(grid, check.begin, &dir);
+    return profile_clock() - start;
 }
 
 long sum(const Grid *grid) {
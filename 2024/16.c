@@ -1,55 +1,144 @@
 #include "aoc.h"
 
-typedef struct Pos Pos;
-struct Pos {
-    long score;
-    Vec2 pos;
-    Vec2 dir;
-    Pos *prev;
-};
+constexpr uint32_t none = UINT32_MAX;
+constexpr long turn = 1000;
+constexpr Vec2 direction[] = {{0, +1}, {+1, 0}, {0, -1}, {-1, 0}};
 
-long lowest_score(const Grid *grid, Set *seen, Arena *arena);
+typedef struct {
+    long length;
+    long count;
+    uint32_t score;
+    uint32_t *head;
+    uint32_t *next;
+    uint32_t *prev;
+    bool *queued;
+} Queue;
+
+Queue queue_create(long length, Arena *arena);
+uint32_t *lowest_score(const Grid *grid, Queue *queue, char start, bool reverse, Arena *arena);
 
 int main(void) {
-    Arena arena = arena_create(32 * mega_byte);
+    const char *fname = input_path("2024/input/16.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 128));
+
+    Grid grid = grid_parse(fname, &arena);
 
-    Grid grid = grid_parse("2024/input/16.txt", &arena);
+    Queue queue = queue_create(4 * grid.rows * grid.cols, &arena);
+    uint32_t *forward = lowest_score(&grid, &queue, 'S', false, &arena);
+    uint32_t *backward = lowest_score(&grid, &queue, 'E', true, &arena);
 
-    Set seen = set_create(&arena);
-    printf("%ld\n", lowest_score(&grid, &seen, &arena));
-    printf("%ld\n", seen.length);
+    Vec2 end = grid_find(&grid, 'E');
+    long best = LONG_MAX;
+    for (long d = 0; d < 4; d++) {
+        best = lmin(best, forward[(4 * ((end.r * grid.cols) + end.c)) + d]);
+    }
+    printf("%ld\n", best);
+
+    long seen = 0;
+    for (long i = 0; i < grid.rows * grid.cols; i++) {
+        for (long d = 0; d < 4; d++) {
+            uint32_t fwd = forward[(4 * i) + d];
+            uint32_t bwd = backward[(4 * i) + d];
+            if (fwd != none && bwd != none && fwd + bwd == best) {
+                seen += 1;
+                break;
+            }
+        }
+    }
+    printf("%ld\n", seen);
 
     arena_destroy(&arena);
 }
 
-long lowest_score(const Grid *grid, Set *seen, Arena *arena) {
-    Pos start = {.pos = grid_find(grid, 'S'), .dir = {0, +1}};
-    long best = LONG_MAX;
-    Dict scores = dict_create(arena, sizeof(long));
-    Heap heap = heap_create(arena, sizeof(Pos), cmp_long);
-    heap_push(&heap, &start, nullptr);
-    while (heap.length) {
-        Pos *cur = heap_pop(&heap, nullptr);
-        long *score = dict_insert(&scores, &cur->pos, sizeof(Vec2[2]), &cur->score);
-        if (score && *score < cur->score) {
-            continue;
+Queue queue_create(long length, Arena *arena) {
+    Queue queue = {.length = length};
+    queue.head = calloc(arena, queue.head, turn + 2);
+    queue.next = calloc(arena, queue.next, length);
+    queue.prev = calloc(arena, queue.prev, length);
+    queue.queued = calloc(arena, queue.queued, length);
+    memset(queue.head, 0xff, sizeof(*queue.head) * (turn + 2));
+    return queue;
+}
+
+void queue_remove(Queue *queue, uint32_t state, uint32_t score) {
+    uint32_t *head = &queue->head[score % (turn + 2)];
+    if (queue->prev[state] != none) {
+        queue->next[queue->prev[state]] = queue->next[state];
+    }
+    else {
+        *head = queue->next[state];
+    }
+    if (queue->next[state] != none) {
+        queue->prev[queue->next[state]] = queue->prev[state];
+    }
+    queue->queued[state] = false;
+    queue->count -= 1;
+}
+
+void queue_push(Queue *queue, uint32_t state, uint32_t score) {
+    uint32_t *head = &queue->head[score % (turn + 2)];
+    queue->prev[state] = none;
+    queue->next[state] = *head;
+    if (*head != none) {
+        queue->prev[*head] = state;
+    }
+    *head = state;
+    queue->queued[state] = true;
+    queue->count += 1;
+}
+
+uint32_t queue_pop(Queue *queue) {
+    while (queue->head[queue->score % (turn + 2)] == none) {
+        queue->score += 1;
+    }
+    uint32_t state = queue->head[queue->score % (turn + 2)];
+    queue_remove(queue, state, queue->score);
+    return state;
+}
+
+void relax(const Grid *grid, Queue *queue, uint32_t *score, Vec2 pos, long d, uint32_t cost) {
+    char chr = grid_get(grid, pos.r, pos.c);
+    if (!chr || chr == '#') {
+        return;
+    }
+    uint32_t state = (4 * ((pos.r * grid->cols) + pos.c)) + d;
+    if (cost >= score[state]) {
+        return;
+    }
+    if (queue->queued[state]) {
+        queue_remove(queue, state, score[state]);
+    }
+    score[state] = cost;
+    queue_push(queue, state, cost);
+}
+
+uint32_t *lowest_score(const Grid *grid, Queue *queue, char start, bool reverse, Arena *arena) {
+    uint32_t *score = calloc(arena, score, queue->length);
+    memset(score, 0xff, sizeof(*score) * queue->length);
+    queue->score = 0;
+    Vec2 pos = grid_find(grid, start);
+    for (long d = 0; d < 4; d++) {
+        if (reverse || d == 0) {
+            relax(grid, queue, score, pos, d, 0);
         }
-        if (grid_get(grid, cur->pos.r, cur->pos.c) == 'E') {
-            best = cur->score;
-            for (auto pos = cur; pos; pos = pos->prev) {
-                set_insert(seen, &pos->pos, sizeof(Vec2));
+    }
+    while (queue->count) {
+        uint32_t state = queue_pop(queue);
+        long cell = state / 4;
+        long d = state % 4;
+        Vec2 cur = {cell / grid->cols, cell % grid->cols};
+        if (!reverse) {
+            array_for_each(long, nd, d, (d + 1) % 4, (d + 3) % 4) {
+                Vec2 nxt = {cur.r + direction[*nd].r, cur.c + direction[*nd].c};
+                relax(grid, queue, score, nxt, *nd, score[state] + (*nd == d ? 1 : turn + 1));
             }
         }
-        array_for_each(Vec2, dir, cur->dir, {-cur->dir.c, cur->dir.r}, {cur->dir.c, -cur->dir.r}) {
-            Pos nxt = {.pos = {cur->pos.r + dir->r, cur->pos.c + dir->c}};
-            if (grid_get(grid, nxt.pos.r, nxt.pos.c) == '#') {
-                continue;
+        else {
+            Vec2 prv = {cur.r - direction[d].r, cur.c - direction[d].c};
+            array_for_each(long, pd, d, (d + 1) % 4, (d + 3) % 4) {
+                relax(grid, queue, score, prv, *pd, score[state] + (*pd == d ? 1 : turn + 1));
             }
-            nxt.dir = *dir;
-            nxt.score = cur->score + (!memcmp(&cur->dir, dir, sizeof(Vec2)) ? 1 : 1001);
-            nxt.prev = cur;
-            heap_push(&heap, &nxt, nullptr);
         }
     }
-    return best;
+    return score;
 }
@@ -1,26 +1,43 @@
 #include "aoc.h"
 
 typedef enum { adv, bxl, bst, jnz, bxc, out, bdv, cdv } Opcode;
+typedef enum { A = 4, B, C } Register;
 
-char *parse(long *a, const char *fname, Arena *arena);
-char *run(long a, char *ret, const char *prg);
-long find(long a, char *ret, const char *prg, long depth);
+typedef struct {
+    Opcode code;
+    long oper;
+} Instr;
+
+typedef struct {
+    long length;
+    Instr *instr;
+    long digits;
+    char *digit;
+} Program;
+
+Program parse(long *a, const char *fname, Arena *arena);
+long run(const Program *prg, long a, char *ret, long size, const char *target);
+long find(const Program *prg, long a, long depth);
 
 int main(void) {
     Arena arena = arena_create(mega_byte);
 
     long a;
-    char *prg = parse(&a, "2024/input/17.txt", &arena);
+    Program prg = parse(&a, input_path("2024/input/17.txt"), &arena);
 
-    char *ret = calloc(&arena, ret, 256);
-    printf("%s\n", run(a, ret, prg));
+    char *ret = calloc(&arena, ret, bufsize);
+    long length = run(&prg, a, ret, bufsize, nullptr);
+    assert(length >= 0);
+    for (long i = 0; i < length; i++) {
+        printf("%d%c", ret[i], i + 1 < length ? ',' : '\n');
+    }
 
-    printf("%ld\n", find(0, ret, prg, 0));
+    printf("%ld\n", find(&prg, 0, 0));
 
     arena_destroy(&arena);
 }
 
-char *parse(long *a, const char *fname, Arena *arena) {
+Program parse(long *a, const char *fname, Arena *arena) {
     FILE *file = fopen(fname, "r");
     assert(file);
     fscanf(file, "Register A: %ld\n", a);
@@ -28,58 +45,156 @@ char *parse(long *a, const char *fname, Arena *arena) {
     for (long i = 0; i < 4; i++) {
         fgets(line, sizeof(line), file);
     }
-    char *str = strchr(line, ' ') + 1;
-    *strchr(str, '\n') = 0;
-    char *prg = strdup(arena, str);
     fclose(file);
+    Program prg = {};
+    prg.digit = calloc(arena, prg.digit, strlen(line));
+    char *token = strtok(strchr(line, ' ') + 1, ",\n");
+    while (token) {
+        prg.digit[prg.digits++] = strtol(token, nullptr, decimal);
+        token = strtok(nullptr, ",\n");
+    }
+    prg.length = prg.digits / 2;
+    prg.instr = calloc(arena, prg.instr, prg.length);
+    for (long i = 0; i < prg.length; i++) {
+        Instr *instr = &prg.instr[i];
+        instr->code = prg.digit[2 * i];
+        instr->oper = prg.digit[(2 * i) + 1];
+        if (instr->code == jnz) {
+            instr->oper /= 2;
+        }
+        else if (instr->code != bxl && instr->code != bxc && instr->oper == 7) {
+            abort();
+        }
+    }
     return prg;
 }
 
-long combo(Opcode op, long a, long b, long c) {
-    switch (op) {
-        case 4: return a;
-        case 5: return b;
-        case 6: return c;
-        case 7: abort();
-        default: return op;
+long run(const Program *prg, long a, char *ret, long size, const char *target) {
+    long reg[7] = {0, 1, 2, 3, a, 0, 0};
+    long length = 0;
+    for (const Instr *ip = prg->instr, *end = prg->instr + prg->length; ip < end; ip++) {
+        long oper = ip->oper;
+        switch (ip->code) {
+            case adv: reg[A] >>= reg[oper]; break;
+            case bxl: reg[B] ^= oper; break;
+            case bst: reg[B] = reg[oper] % octal; break;
+            case jnz:
+                if (reg[A]) {
+                    ip = prg->instr + oper - 1;
+                }
+                break;
+            case bxc: reg[B] ^= reg[C]; break;
+            case out:
+                if (length == size) {
+                    return -1;
+                }
+                ret[length] = reg[oper] % octal;
+                if (target && ret[length] != target[length]) {
+                    return -1;
+                }
+                length += 1;
+                break;
+            case bdv: reg[B] = reg[A] >> reg[oper]; break;
+            case cdv: reg[C] = reg[A] >> reg[oper]; break;
+        }
     }
+    return length;
 }
 
-char *run(long a, char *ret, const char *prg) {
-    long b = 0;
-    long c = 0;
-    ret[0] = 0;
-    for (auto p = prg, end = prg + strlen(prg); p < end; p += 4) {
-        Opcode code = p[0] - '0';
-        Opcode oper = p[2] - '0';
-        switch (code) {
-            case adv: a >>= combo(oper, a, b, c); break;
-            case bxl: b ^= oper; break;
-            case bst: b = combo(oper, a, b, c) % octal; break;
-            case jnz:
-                if (a) {
-                    p = prg + (long)(2 * oper) - 4;
+long run_scalar(const Program *prg, long a, long match, long size, const char *target) {
+    char ret[bufsize];
+    for (long i = 0; i < octal; i++) {
+        if ((match & (1 << i)) && run(prg, (octal * a) + i, ret, size, target) != size) {
+            match &= ~(1 << i);
+        }
+    }
+    return match;
+}
+
+long run_batch(const Program *prg, long a, long size, const char *target) {
+    long reg[7][octal] = {};
+    for (long i = 0; i < octal; i++) {
+        for (long k = 0; k < A; k++) {
+            reg[k][i] = k;
+        }
+        reg[A][i] = (octal * a) + i;
+    }
+    long match = (1 << octal) - 1;
+    long length = 0;
+    for (const Instr *ip = prg->instr, *end = prg->instr + prg->length; ip < end; ip++) {
+        const long *oper = reg[ip->oper];
+        switch (ip->code) {
+            case adv:
+                for (long i = 0; i < octal; i++) {
+                    reg[A][i] >>= oper[i];
+                }
+                break;
+            case bxl:
+                for (long i = 0; i < octal; i++) {
+                    reg[B][i] ^= ip->oper;
+                }
+                break;
+            case bst:
+                for (long i = 0; i < octal; i++) {
+                    reg[B][i] = oper[i] % octal;
+                }
+                break;
+            case jnz: {
+                long jump = 0;
+                for (long i = 0; i < octal; i++) {
+                    jump |= (long)(reg[A][i] != 0) << i;
+                }
+                if ((jump & match) == match) {
+                    ip = prg->instr + ip->oper - 1;
+                }
+                else if (jump & match) {
+                    return run_scalar(prg, a, match, size, target);
+                }
+                break;
+            }
+            case bxc:
+                for (long i = 0; i < octal; i++) {
+                    reg[B][i] ^= reg[C][i];
+                }
+                break;
+            case out:
+                if (length == size) {
+                    return 0;
+                }
+                for (long i = 0; i < octal; i++) {
+                    if (oper[i] % octal != target[length]) {
+                        match &= ~(1 << i);
+                    }
+                }
+                if (!match) {
+                    return 0;
+                }
+                length += 1;
+                break;
+            case bdv:
+                for (long i = 0; i < octal; i++) {
+                    reg[B][i] = reg[A][i] >> oper[i];
+                }
+                break;
+            case cdv:
+                for (long i = 0; i < octal; i++) {
+                    reg[C][i] = reg[A][i] >> oper[i];
                 }
                 break;
-            case bxc: b ^= c; break;
-            case out: strcat(ret, (char[]){'0' + (combo(oper, a, b, c) % octal), ',', 0}); break;
-            case bdv: b = a >> combo(oper, a, b, c); break;
-            case cdv: c = a >> combo(oper, a, b, c); break;
         }
     }
-    ret[strlen(ret) - 1] = 0;
-    return ret;
+    return length == size ? match : 0;
 }
 
-long find(long a, char *ret, const char *prg, long depth) {
-    long prglen = strlen(prg);
-    if (2 * depth >= prglen) {
+long find(const Program *prg, long a, long depth) {
+    if (depth >= prg->digits) {
         return a;
     }
+    long size = depth + 1;
+    long match = run_batch(prg, a, size, prg->digit + prg->digits - size);
     for (long i = 0; i < octal; i++) {
-        long aa = (octal * a) + i;
-        if (run(aa, ret, prg)[0] == prg[prglen - (2 * depth) - 1]) {
-            long res = find(aa, ret, prg, depth + 1);
+        if (match & (1 << i)) {
+            long res = find(prg, (octal * a) + i, depth + 1);
             if (res) {
                 return res;
             }
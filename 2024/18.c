@@ -2,27 +2,35 @@
 
 void parse(List *byte, const char *fname);
 long distance(const Grid *grid, Arena arena);
+Vec2 *blocking_reverse(const List *byte, long size, Arena arena);
+Vec2 *blocking_bisect(const List *byte, long size, Arena arena);
 
-int main(void) {
-    Arena arena = arena_create(mega_byte);
+int main(int argc, char **argv) {
+    long size = argc > 1 ? strtol(argv[1], nullptr, decimal) : 71;
+    long fallen = argc > 2 ? strtol(argv[2], nullptr, decimal) : 1024;
+    bool bisect = argc > 3 && !strcmp(argv[3], "bisect");
+    assert(size > 0);
+
+    const char *fname = input_path("2024/input/18.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 16) + (size * size * 64));
 
     List byte = list_create(&arena, sizeof(Vec2), nullptr);
-    parse(&byte, "2024/input/18.txt");
+    parse(&byte, fname);
 
-    long size = 71;
     Grid grid = grid_create(size, size, '.', &arena);
-
-    long count = 1024;
+    long count = 0;
     list_for_each(item, &byte) {
-        Vec2 *pos = item->data;
-        grid_set(&grid, pos->r, pos->c, '#');
-        if (--count == 0) {
-            printf("%ld\n", distance(&grid, arena));
-        }
-        if (count < 0 && distance(&grid, arena) < 0) {
-            printf("%ld,%ld\n", pos->c, pos->r);
+        if (count++ == fallen) {
             break;
         }
+        Vec2 *pos = item->data;
+        grid_set(&grid, pos->r, pos->c, '#');
+    }
+    printf("%ld\n", distance(&grid, arena));
+
+    Vec2 *pos = bisect ? blocking_bisect(&byte, size, arena) : blocking_reverse(&byte, size, arena);
+    if (pos) {
+        printf("%ld,%ld\n", pos->c, pos->r);
     }
 
     arena_destroy(&arena);
@@ -63,3 +71,91 @@ long distance(const Grid *grid, Arena arena) {
     }
     return -1;
 }
+
+long find(long *parent, long i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void open_cell(long *parent, const long *blocked, long size, long r, long c) {
+    long i = (r * size) + c;
+    array_for_each(Vec2, dir, {-1, 0}, {+1, 0}, {0, -1}, {0, +1}) {
+        long nr = r + dir->r;
+        long nc = c + dir->c;
+        if (nr < 0 || size <= nr || nc < 0 || size <= nc || blocked[(nr * size) + nc]) {
+            continue;
+        }
+        parent[find(parent, (nr * size) + nc)] = find(parent, i);
+    }
+}
+
+Vec2 *blocking_reverse(const List *byte, long size, Arena arena) {
+    long *parent = calloc(&arena, parent, size * size);
+    long *blocked = calloc(&arena, blocked, size * size);
+    list_for_each(item, byte) {
+        Vec2 *pos = item->data;
+        blocked[(pos->r * size) + pos->c] += 1;
+    }
+    for (long i = 0; i < size * size; i++) {
+        parent[i] = i;
+    }
+    for (long r = 0; r < size; r++) {
+        for (long c = 0; c < size; c++) {
+            if (!blocked[(r * size) + c]) {
+                open_cell(parent, blocked, size, r, c);
+            }
+        }
+    }
+    long start = 0;
+    long end = (size * size) - 1;
+    if (!blocked[start] && !blocked[end] && find(parent, start) == find(parent, end)) {
+        return nullptr;
+    }
+    for (auto item = byte->end; item; item = item->prev) {
+        Vec2 *pos = item->data;
+        if (--blocked[(pos->r * size) + pos->c] == 0) {
+            open_cell(parent, blocked, size, pos->r, pos->c);
+        }
+        if (!blocked[start] && !blocked[end] && find(parent, start) == find(parent, end)) {
+            return pos;
+        }
+    }
+    return nullptr;
+}
+
+Vec2 *blocking_bisect(const List *byte, long size, Arena arena) {
+    long lo = 0;
+    long hi = byte->length;
+    while (lo < hi) {
+        long mid = (lo + hi) / 2;
+        Arena scratch = arena;
+        Grid grid = grid_create(size, size, '.', &scratch);
+        long count = 0;
+        list_for_each(item, byte) {
+            if (count++ > mid) {
+                break;
+            }
+            Vec2 *pos = item->data;
+            grid_set(&grid, pos->r, pos->c, '#');
+        }
+        if (distance(&grid, scratch) < 0) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    if (lo == byte->length) {
+        return nullptr;
+    }
+    long count = 0;
+    list_for_each(item, byte) {
+        if (count++ == lo) {
+            return item->data;
+        }
+    }
+    return nullptr;
+}
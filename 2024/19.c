@@ -1,21 +1,61 @@
 #include "aoc.h"
 
+typedef struct {
+    long next[5];
+    bool towel;
+} Node;
+
+typedef struct {
+    long length;
+    Node *node;
+} Trie;
+
+typedef struct {
+    const Trie *trie;
+    char **design;
+    long length;
+    long *ways;
+    long part1;
+    long part2;
+} Task;
+
 void parse(List *pattern, List *design, const char *fname, Arena *arena);
-long possible(const List *pattern, const char *design, Arena arena);
+Trie compile(const List *pattern, Arena *arena);
+long possible(const Trie *trie, const char *design, long *ways);
+void *solve(void *arg);
 
 int main(void) {
-    Arena arena = arena_create(mega_byte);
+    const char *fname = input_path("2024/input/19.txt");
+    Arena arena = arena_create(input_arena(fname, mega_byte, 64));
 
     List pattern = list_create(&arena, 0, nullptr);
     List design = list_create(&arena, 0, nullptr);
-    parse(&pattern, &design, "2024/input/19.txt", &arena);
+    parse(&pattern, &design, fname, &arena);
+    Trie trie = compile(&pattern, &arena);
+
+    char **batch = calloc(&arena, batch, design.length);
+    long length = 0;
+    long longest = 0;
+    list_for_each(item, &design) {
+        batch[length++] = item->data;
+        longest = lmax(longest, strlen(item->data));
+    }
+
+    long count = thread_count(length);
+    Task *task = calloc(&arena, task, count);
+    for (long i = 0; i < count; i++) {
+        long begin = length * i / count;
+        long end = length * (i + 1) / count;
+        task[i] = (Task){.trie = &trie, .design = batch + begin, .length = end - begin};
+        task[i].ways = calloc(&arena, task[i].ways, longest + 1);
+    }
+    parallel_run(solve, task, count, sizeof(*task));
 
     long part1 = 0;
     long part2 = 0;
-    list_for_each(item, &design) {
-        long count = possible(&pattern, item->data, arena);
-        part1 += count > 0;
-        part2 += count;
+    for (long i = 0; i < count; i++) {
+        part1 += task[i].part1;
+        part2 += task[i].part2;
     }
     printf("%ld\n", part1);
     printf("%ld\n", part2);
@@ -41,25 +81,68 @@ void parse(List *pattern, List *design, const char *fname, Arena *arena) {
     fclose(file);
 }
 
-long possible(const List *pattern, const char *design, Arena arena) {
-    static Dict cache = {};
-    if (arena.data) {
-        cache = dict_create(&arena, sizeof(long));
+long color(char chr) {
+    switch (chr) {
+        case 'w': return 0;
+        case 'u': return 1;
+        case 'b': return 2;
+        case 'r': return 3;
+        case 'g': return 4;
+        default: return -1;
     }
-    if (design[0] == 0) {
-        return 1;
-    }
-    long *cached = dict_find(&cache, design, 0);
-    if (cached) {
-        return *cached;
+}
+
+Trie compile(const List *pattern, Arena *arena) {
+    long size = 1;
+    list_for_each(item, pattern) {
+        size += strlen(item->data);
     }
-    long count = 0;
+    Trie trie = {.length = 1};
+    trie.node = calloc(arena, trie.node, size);
     list_for_each(item, pattern) {
-        long length = strlen(item->data);
-        if (!strncmp(item->data, design, length)) {
-            count += possible(pattern, design + length, (Arena){});
+        long node = 0;
+        for (char *chr = item->data; *chr; chr++) {
+            assert(color(*chr) >= 0);
+            long *next = &trie.node[node].next[color(*chr)];
+            if (!*next) {
+                *next = trie.length++;
+            }
+            node = *next;
+        }
+        trie.node[node].towel = true;
+    }
+    return trie;
+}
+
+void *solve(void *arg) {
+    Task *task = arg;
+    for (long i = 0; i < task->length; i++) {
+        long count = possible(task->trie, task->design[i], task->ways);
+        task->part1 += count > 0;
+        task->part2 += count;
+    }
+    return nullptr;
+}
+
+long possible(const Trie *trie, const char *design, long *ways) {
+    long length = strlen(design);
+    memset(ways, 0, (length + 1) * sizeof(*ways));
+    ways[0] = 1;
+    for (long i = 0; i < length; i++) {
+        if (!ways[i]) {
+            continue;
+        }
+        long node = 0;
+        for (long j = i; j < length; j++) {
+            long chr = color(design[j]);
+            if (chr < 0 || !trie->node[node].next[chr]) {
+                break;
+            }
+            node = trie->node[node].next[chr];
+            if (trie->node[node].towel) {
+                ways[j + 1] += ways[i];
+            }
         }
     }
-    dict_insert(&cache, design, 0, &count);
-    return count;
+    return ways[length];
 }
@@ -6,7 +6,7 @@ long cheat(const Dict *dist, const Vec2 *pos, const long *d0, long time);
 int main(void) {
     Arena arena = arena_create(2 * mega_byte);
 
-    Grid grid = grid_parse("2024/input/20.txt", &arena);
+    Grid grid = grid_parse(input_path("2024/input/20.txt"), &arena);
     Dict dist = distance(&grid, &arena);
 
     long part1 = 0;
@@ -1,27 +1,39 @@
 #include "aoc.h"
 
+typedef unsigned _BitInt(128) Cost;
+
+typedef struct {
+    long cols;
+    long keys;
+    const char *key;
+    Cost *cost;
+} Pad;
+
 void parse(List *code, const char *fname, Arena *arena);
-Dict numpad(Arena *arena);
-Dict dirpad(Arena *arena);
-long complexity(const char *code, const Dict *num, const Dict *dir, long robots, Arena *arena);
+Pad keypad(const char *key, long cols, const Pad *dir, Arena *arena);
+Cost complexity(const char *code, const Pad *num);
+Cost cost_add(Cost a, Cost b);
+Cost cost_mul(Cost a, Cost b);
 
 int main(void) {
     Arena arena = arena_create(mega_byte);
 
     List code = list_create(&arena, 0, nullptr);
-    parse(&code, "2024/input/21.txt", &arena);
+    parse(&code, input_path("2024/input/21.txt"), &arena);
 
-    Dict num = numpad(&arena);
-    Dict dir = dirpad(&arena);
-
-    long part1 = 0;
-    long part2 = 0;
-    list_for_each(item, &code) {
-        part1 += complexity(item->data, &num, &dir, 2, &arena);
-        part2 += complexity(item->data, &num, &dir, 25, &arena);
+    long robots[] = {2, 25};
+    for (long part = 0; part < 2; part++) {
+        Pad dir = keypad("#^A<v>", 3, nullptr, &arena);
+        for (long i = 0; i < robots[part]; i++) {
+            dir = keypad(dir.key, dir.cols, &dir, &arena);
+        }
+        Pad num = keypad("789456123#0A", 3, &dir, &arena);
+        Cost sum = 0;
+        list_for_each(item, &code) {
+            sum = cost_add(sum, complexity(item->data, &num));
+        }
+        print_u128(sum);
     }
-    printf("%ld\n", part1);
-    printf("%ld\n", part2);
 
     arena_destroy(&arena);
 }
@@ -37,156 +49,74 @@ void parse(List *code, const char *fname, Arena *arena) {
     fclose(file);
 }
 
-typedef struct {
-    Vec2 pos;
-    char chr;
-    void *prev;
-} State;
-
-typedef struct {
-    char str[9][7];
-    long count;
-} Path;
-
-long distance(const State *state) {
-    return !!state->chr + (state->prev ? distance(state->prev) : 0);
-}
-
-void reverse_append(char *path, const State *state) {
-    if (state->prev) {
-        reverse_append(path, state->prev);
+Cost sequence(const Pad *pad, const char *seq) {
+    Cost cost = 0;
+    for (const char *a = "A", *b = seq; *b; a = b, b++) {
+        long i = strchr(pad->key, *a) - pad->key;
+        long j = strchr(pad->key, *b) - pad->key;
+        cost = cost_add(cost, pad->cost[(i * pad->keys) + j]);
     }
-    strncat(path, &state->chr, 1);
+    return cost;
 }
 
-typedef struct {
-    long r;
-    long c;
-    char chr;
-} Dir;
-
-void find(Path *path, const Grid *grid, char start, char end, Arena arena) {
-    State state = {.pos = grid_find(grid, start)};
-    List queue = list_create(&arena, sizeof(State), nullptr);
-    list_append(&queue, &state);
-    long best = LONG_MAX;
-    while (queue.length) {
-        State *cur = list_pop(&queue, 0);
-        if (grid_get(grid, cur->pos.r, cur->pos.c) == end) {
-            long dist = distance(cur);
-            if (dist <= best) {
-                best = dist;
-                reverse_append(path->str[path->count], cur);
-                strcat(path->str[path->count], "A");
-                path->count += 1;
-                continue;
-            }
-            return;
-        }
-        array_for_each(Dir, dir, {-1, 0, '^'}, {+1, 0, 'v'}, {0, -1, '<'}, {0, +1, '>'}) {
-            State nxt = {.pos = {cur->pos.r + dir->r, cur->pos.c + dir->c}};
-            if (!grid_get(grid, nxt.pos.r, nxt.pos.c)) {
-                continue;
-            }
-            nxt.chr = dir->chr;
-            nxt.prev = cur;
-            list_append(&queue, &nxt);
-        }
+long moves(const Pad *pad, long a, long b, char seq[2][bufsize]) {
+    Vec2 pa = {a / pad->cols, a % pad->cols};
+    Vec2 pb = {b / pad->cols, b % pad->cols};
+    char vert[bufsize] = "";
+    char horz[bufsize] = "";
+    for (long r = pa.r; r != pb.r; r += pb.r > pa.r ? 1 : -1) {
+        strcat(vert, pb.r > pa.r ? "v" : "^");
     }
-}
-
-Dict numpad(Arena *arena) {
-    Grid grid = {.rows = 4, .cols = 3};
-    grid.data = strdup(arena, "789456123#0A");
-    *strchr(grid.data, '#') = 0;
-    Dict paths = dict_create(arena, sizeof(Path));
-    for (auto a = "A0123456789"; *a; a++) {
-        for (auto b = "A0123456789"; *b; b++) {
-            Path path = {};
-            find(&path, &grid, *a, *b, *arena);
-            dict_insert(&paths, (char[]){*a, *b}, sizeof(char[2]), &path);
-        }
+    for (long c = pa.c; c != pb.c; c += pb.c > pa.c ? 1 : -1) {
+        strcat(horz, pb.c > pa.c ? ">" : "<");
     }
-    return paths;
-}
-
-Dict dirpad(Arena *arena) {
-    Grid grid = {.rows = 2, .cols = 3};
-    grid.data = strdup(arena, "#^A<v>");
-    *strchr(grid.data, '#') = 0;
-    Dict paths = dict_create(arena, sizeof(Path));
-    for (auto a = "A<v>^"; *a; a++) {
-        for (auto b = "A<v>^"; *b; b++) {
-            Path path = {};
-            find(&path, &grid, *a, *b, *arena);
-            dict_insert(&paths, (char[]){*a, *b}, sizeof(char[2]), &path);
-        }
+    long count = 0;
+    if (pad->key[(pa.r * pad->cols) + pb.c] != '#') {
+        snprintf(seq[count++], bufsize, "%s%sA", horz, vert);
+    }
+    if (pad->key[(pb.r * pad->cols) + pa.c] != '#' && horz[0] && vert[0]) {
+        snprintf(seq[count++], bufsize, "%s%sA", vert, horz);
     }
-    return paths;
+    return count;
 }
 
-List generate(const char *code, const Dict *pad, Arena *arena) {
-    List seq = list_create(arena, 0, nullptr);
-    for (const char *a = "A", *b = code; *b; a = b, b++) {
-        Path *path = dict_find(pad, (char[]){*a, *b}, sizeof(char[2]));
-        long length = seq.length;
-        if (length == 0) {
-            for (long i = 0; i < path->count; i++) {
-                list_append(&seq, strdup(arena, path->str[i]));
+Pad keypad(const char *key, long cols, const Pad *dir, Arena *arena) {
+    Pad pad = {.cols = cols, .keys = strlen(key), .key = key};
+    pad.cost = calloc(arena, pad.cost, pad.keys * pad.keys);
+    for (long a = 0; a < pad.keys; a++) {
+        for (long b = 0; b < pad.keys; b++) {
+            if (key[a] == '#' || key[b] == '#') {
+                continue;
             }
-        }
-        else {
-            for (auto item = seq.begin; length--; item = item->next) {
-                char *str = item->data;
-                item->data = strapp(arena, (char *)strdup(arena, str), path->str[0]);
-                for (long i = 1; i < path->count; i++) {
-                    list_append(&seq, strapp(arena, (char *)strdup(arena, str), path->str[i]));
-                }
+            if (!dir) {
+                pad.cost[(a * pad.keys) + b] = 1;
+                continue;
             }
+            char seq[2][bufsize];
+            long count = moves(&pad, a, b, seq);
+            Cost cost = sequence(dir, seq[0]);
+            for (long i = 1; i < count; i++) {
+                Cost alt = sequence(dir, seq[i]);
+                cost = alt < cost ? alt : cost;
+            }
+            pad.cost[(a * pad.keys) + b] = cost;
         }
     }
-    return seq;
+    return pad;
 }
 
-typedef struct {
-    long depth;
-    char code[];
-} Cache;
+Cost complexity(const char *code, const Pad *num) {
+    return cost_mul(strtol(code, nullptr, decimal), sequence(num, code));
+}
 
-long get_length(const char *code, const Dict *dir, long depth, Arena *arena) {
-    static Dict cache = {};
-    if (!cache.arena) {
-        cache = dict_create(arena, sizeof(long));
-    }
-    long size = sizeof(Cache) + sizeof(char[strlen(code) + 1]);
-    Cache *key = arena_malloc(arena, 1, size, alignof(Cache));
-    key->depth = depth;
-    strcpy(key->code, code);
-    long *cached = dict_find(&cache, key, size);
-    if (cached) {
-        return *cached;
-    }
-    if (depth == 0) {
-        return strlen(code);
-    }
-    long length = 0;
-    for (const char *a = "A", *b = code; *b; a = b, b++) {
-        Path *path = dict_find(dir, (char[]){*a, *b}, sizeof(char[2]));
-        long len = LONG_MAX;
-        for (long i = 0; i < path->count; i++) {
-            len = lmin(len, get_length(path->str[i], dir, depth - 1, arena));
-        }
-        length += len;
-    }
-    dict_insert(&cache, key, size, &length);
-    return length;
+// costs grow by about 2.5x per robot, so with the code values as factors 128 bits last for about
+// 85 robots, overflowing chains fail these asserts instead of wrapping around
+Cost cost_add(Cost a, Cost b) {
+    assert(a + b >= a);
+    return a + b;
 }
 
-long complexity(const char *code, const Dict *num, const Dict *dir, long robots, Arena *arena) {
-    List seq = generate(code, num, arena);
-    long length = LONG_MAX;
-    list_for_each(item, &seq) {
-        length = lmin(length, get_length(item->data, dir, robots, arena));
-    }
-    return strtol(code, nullptr, decimal) * length;
+Cost cost_mul(Cost a, Cost b) {
+    assert(!a || (a * b) / a == b);
+    return a * b;
 }
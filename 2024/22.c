@@ -4,11 +4,12 @@ void parse(List *number, const char *fname);
 long evolve(Dict *price, long number, long n, Arena scratch);
 
 int main(void) {
-    Arena arena = arena_create(7 * mega_byte);
+    const char *fname = input_path("2024/input/22.txt");
+    Arena arena = arena_create(input_arena(fname, 7 * mega_byte, 16));
     Arena scratch = arena_scratch_create(&arena, mega_byte);
 
     List number = list_create(&arena, sizeof(long), nullptr);
-    parse(&number, "2024/input/22.txt");
+    parse(&number, fname);
 
     long part1 = 0;
     Dict price = dict_create(&arena, sizeof(long));
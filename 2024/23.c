@@ -7,7 +7,7 @@ int main(void) {
     Arena arena = arena_create(mega_byte);
 
     Dict network = dict_create(&arena, sizeof(List));
-    parse(&network, "2024/input/23.txt", &arena);
+    parse(&network, input_path("2024/input/23.txt"), &arena);
 
     long part1 = 0;
     char part2[bufsize] = "";
@@ -6,34 +6,68 @@ typedef struct {
     GateType type;
     char *input[2];
     long value;
+    long index;
 } Gate;
 
+typedef struct {
+    GateType type;
+    long output;
+    long input[2];
+} Op;
+
+typedef struct {
+    long wires;
+    char **name;
+    Op *gate;
+    long *value;
+    long *uses;
+    long bits;
+    long outputs;
+    long *x;
+    long *y;
+    long *z;
+    long ops;
+    Op *op;
+    char *mark;
+} Netlist;
+
 void parse(Dict *network, const char *fname, Arena *arena);
-void compute(const Dict *network, Gate *gate);
-Set swapped(const Dict *network, Arena *arena);
+Netlist compile(const Dict *network, Arena *arena);
+bool sort(Netlist *net);
+void evaluate(const Netlist *net, uint64_t *value);
+long swapped(const Netlist *net, long *wrong);
+bool repair(Netlist *net, long *wrong, long n, uint64_t *value);
 
 int main(void) {
     Arena arena = arena_create(mega_byte);
 
     Dict network = dict_create(&arena, sizeof(Gate));
-    parse(&network, "2024/input/24.txt", &arena);
+    parse(&network, input_path("2024/input/24.txt"), &arena);
+
+    Netlist net = compile(&network, &arena);
+    uint64_t *value = calloc(&arena, value, net.wires);
 
+    assert(net.outputs < 64);
     long part1 = 0;
-    dict_for_each(item, &network) {
-        char *name = item->key.data;
-        Gate *gate = item->data;
-        compute(&network, gate);
-        switch (name[0]) {
-            case 'z': part1 |= gate->value << strtol(name + 1, nullptr, decimal); break;
-            default: continue;
-        }
+    for (long i = 0; i < net.wires; i++) {
+        value[i] = net.value[i] ? UINT64_MAX : 0;
+    }
+    evaluate(&net, value);
+    for (long i = 0; i < net.outputs; i++) {
+        part1 |= (long)(value[net.z[i]] & 1) << i;
     }
     printf("%ld\n", part1);
 
-    Set wrong = swapped(&network, &arena);
+    long *wrong = calloc(&arena, wrong, net.wires);
+    long count = swapped(&net, wrong);
     List list = list_create(&arena, 0, cmp_string);
-    set_for_each(item, &wrong) {
-        list_append(&list, item->key.data);
+    for (long i = 0; i < count; i++) {
+        list_append(&list, net.name[wrong[i]]);
+    }
+    if (profile_enabled()) {
+        profile("repair") {
+            profile_count("unrepaired", !repair(&net, wrong, count, value));
+        }
     }
     list_sort(&list, nullptr);
     list_for_each(item, &list) {
@@ -62,7 +96,6 @@ void parse(Dict *network, const char *fname, Arena *arena) {
         *strchr(line, '\n') = 0;
         char *token = strtok(line, " ->");
         Gate gate = {};
-        gate.value = -1;
         gate.input[0] = strdup(arena, token);
         token = strtok(nullptr, " ->");
         switch (token[0]) {
@@ -79,76 +112,181 @@ void parse(Dict *network, const char *fname, Arena *arena) {
     fclose(file);
 }
 
-void compute(const Dict *network, Gate *gate) {
-    if (gate->value != -1) {
-        return;
-    }
-    Gate *input[2];
-    input[0] = dict_find(network, gate->input[0], 0);
-    input[1] = dict_find(network, gate->input[1], 0);
-    compute(network, input[0]);
-    compute(network, input[1]);
-    if (input[0]->value != -1 && input[1]->value != -1) {
-        switch (gate->type) {
-            case AND: gate->value = input[0]->value & input[1]->value; break;
-            case XOR: gate->value = input[0]->value ^ input[1]->value; break;
-            case OR: gate->value = input[0]->value | input[1]->value; break;
-            default: unreachable();
+Netlist compile(const Dict *network, Arena *arena) {
+    Netlist net = {.wires = network->length};
+    net.name = calloc(arena, net.name, net.wires);
+    net.gate = calloc(arena, net.gate, net.wires);
+    net.value = calloc(arena, net.value, net.wires);
+    net.uses = calloc(arena, net.uses, net.wires);
+    net.mark = calloc(arena, net.mark, net.wires);
+    net.x = calloc(arena, net.x, net.wires);
+    net.y = calloc(arena, net.y, net.wires);
+    net.z = calloc(arena, net.z, net.wires);
+    long index = 0;
+    dict_for_each(item, network) {
+        Gate *gate = item->data;
+        gate->index = index++;
+    }
+    dict_for_each(item, network) {
+        char *name = item->key.data;
+        Gate *gate = item->data;
+        Op *op = &net.gate[gate->index];
+        net.name[gate->index] = name;
+        net.value[gate->index] = gate->value;
+        op->type = gate->type;
+        op->output = gate->index;
+        long bit = strtol(name + 1, nullptr, decimal);
+        switch (name[0]) {
+            case 'x':
+                net.x[bit] = gate->index;
+                net.bits = lmax(net.bits, bit + 1);
+                break;
+            case 'y': net.y[bit] = gate->index; break;
+            case 'z':
+                net.z[bit] = gate->index;
+                net.outputs = lmax(net.outputs, bit + 1);
+                break;
+            default: break;
         }
+        if (gate->type == NONE) {
+            continue;
+        }
+        for (long i = 0; i < 2; i++) {
+            Gate *input = dict_find(network, gate->input[i], 0);
+            op->input[i] = input->index;
+            net.uses[input->index] |= 1 << gate->type;
+        }
+        net.ops += 1;
     }
+    net.op = calloc(arena, net.op, net.ops);
+    bool acyclic = sort(&net);
+    assert(acyclic);
+    return net;
 }
 
-char *largest_bit(const Dict *network) {
-    char *zmax = "z00";
-    dict_for_each(item, network) {
-        char *name = item->key.data;
-        if (name[0] == 'z' &&
-            strtol(name + 1, nullptr, decimal) > strtol(zmax + 1, nullptr, decimal)) {
-            zmax = name;
+bool visit(Netlist *net, long wire) {
+    if (net->mark[wire] == 2) {
+        return true;
+    }
+    if (net->mark[wire] == 1) {
+        return false;
+    }
+    net->mark[wire] = 1;
+    const Op *gate = &net->gate[wire];
+    if (gate->type != NONE) {
+        if (!visit(net, gate->input[0]) || !visit(net, gate->input[1])) {
+            return false;
         }
+        net->op[net->ops++] = *gate;
     }
-    return zmax;
+    net->mark[wire] = 2;
+    return true;
 }
 
-Set swapped(const Dict *network, Arena *arena) {
-    Set wrong = set_create(arena);
-    char *zmax = largest_bit(network);
-    dict_for_each(a, network) {
-        char *a_name = a->key.data;
-        Gate *a_gate = a->data;
-        char **a_input = a_gate->input;
-        if (!a_input[0] || !a_input[1]) {
-            continue;
+bool sort(Netlist *net) {
+    memset(net->mark, 0, net->wires);
+    net->ops = 0;
+    for (long i = 0; i < net->wires; i++) {
+        if (!visit(net, i)) {
+            return false;
         }
-        if (a_name[0] == 'z' && a_gate->type != XOR && strcmp(a_name, zmax)) {
-            set_insert(&wrong, a_name, 0);
+    }
+    return true;
+}
+
+void evaluate(const Netlist *net, uint64_t *value) {
+    for (const Op *op = net->op, *end = net->op + net->ops; op < end; op++) {
+        uint64_t a = value[op->input[0]];
+        uint64_t b = value[op->input[1]];
+        switch (op->type) {
+            case AND: value[op->output] = a & b; break;
+            case XOR: value[op->output] = a ^ b; break;
+            case OR: value[op->output] = a | b; break;
+            default: unreachable();
         }
-        if (a_gate->type == XOR && !strchr("xyz", a_name[0]) && !strchr("xyz", a_input[0][0]) &&
-            !strchr("xyz", a_input[1][0])) {
-            set_insert(&wrong, a_name, 0);
+    }
+}
+
+uint64_t random_word(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+bool verify(const Netlist *net, long rounds, uint64_t *value) {
+    if (net->outputs != net->bits + 1) {
+        return false;
+    }
+    uint64_t state = 0;
+    for (long round = 0; round < rounds; round++) {
+        for (long i = 0; i < net->bits; i++) {
+            value[net->x[i]] = random_word(&state);
+            value[net->y[i]] = random_word(&state);
         }
-        if (a_gate->type == AND && strcmp("x00", a_input[0]) && strcmp("x00", a_input[1])) {
-            dict_for_each(b, network) {
-                Gate *b_gate = b->data;
-                char **b_input = b_gate->input;
-                if (b_input[0] && b_input[1] &&
-                    (!strcmp(a_name, b_input[0]) || !strcmp(a_name, b_input[1])) &&
-                    b_gate->type != OR) {
-                    set_insert(&wrong, a_name, 0);
-                }
+        evaluate(net, value);
+        uint64_t carry = 0;
+        for (long i = 0; i < net->bits; i++) {
+            uint64_t x = value[net->x[i]];
+            uint64_t y = value[net->y[i]];
+            if (value[net->z[i]] != (x ^ y ^ carry)) {
+                return false;
             }
+            carry = (x & y) | (carry & (x ^ y));
         }
-        if (a_gate->type == XOR) {
-            dict_for_each(b, network) {
-                Gate *b_gate = b->data;
-                char **b_input = b_gate->input;
-                if (b_input[0] && b_input[1] &&
-                    (!strcmp(a_name, b_input[0]) || !strcmp(a_name, b_input[1])) &&
-                    b_gate->type == OR) {
-                    set_insert(&wrong, a_name, 0);
-                }
-            }
+        if (value[net->z[net->bits]] != carry) {
+            return false;
+        }
+    }
+    return true;
+}
+
+long swapped(const Netlist *net, long *wrong) {
+    long count = 0;
+    long zmax = net->z[net->outputs - 1];
+    for (long a = 0; a < net->wires; a++) {
+        char *a_name = net->name[a];
+        const Op *a_gate = &net->gate[a];
+        const long *a_input = a_gate->input;
+        if (a_gate->type == NONE) {
+            continue;
+        }
+        if ((a_name[0] == 'z' && a_gate->type != XOR && a != zmax) ||
+            (a_gate->type == XOR && !strchr("xyz", a_name[0]) &&
+             !strchr("xyz", net->name[a_input[0]][0]) &&
+             !strchr("xyz", net->name[a_input[1]][0])) ||
+            (a_gate->type == AND && a_input[0] != net->x[0] && a_input[1] != net->x[0] &&
+             (net->uses[a] & ~(1 << OR))) ||
+            (a_gate->type == XOR && (net->uses[a] & (1 << OR)))) {
+            wrong[count++] = a;
+        }
+    }
+    return count;
+}
+
+void exchange(Netlist *net, long a, long b) {
+    Op gate = net->gate[a];
+    net->gate[a] = net->gate[b];
+    net->gate[b] = gate;
+    net->gate[a].output = a;
+    net->gate[b].output = b;
+}
+
+bool repair(Netlist *net, long *wrong, long n, uint64_t *value) {
+    if (n == 0) {
+        return sort(net) && verify(net, 16, value);
+    }
+    for (long i = 1; i < n; i++) {
+        long tmp = wrong[1];
+        wrong[1] = wrong[i];
+        wrong[i] = tmp;
+        exchange(net, wrong[0], wrong[1]);
+        if (repair(net, wrong + 2, n - 2, value)) {
+            return true;
         }
+        exchange(net, wrong[0], wrong[1]);
+        wrong[i] = wrong[1];
+        wrong[1] = tmp;
     }
-    return wrong;
+    return false;
 }
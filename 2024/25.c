@@ -8,7 +8,7 @@ int main(void) {
 
     List lock = list_create(&arena, sizeof(long[5]), nullptr);
     List key = list_create(&arena, sizeof(long[5]), nullptr);
-    parse(&lock, &key, "2024/input/25.txt");
+    parse(&lock, &key, input_path("2024/input/25.txt"));
 
     long part1 = 0;
     list_for_each(item1, &lock) {
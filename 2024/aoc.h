@@ -1,10 +1,21 @@
 #pragma once
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // clock_gettime, pthreads, sched_getaffinity
+#endif
+
 #include <assert.h>
 #include <ctype.h>
 #include <limits.h>
 #include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "../cdsa/arena.h"
 #include "../cdsa/dict.h"
@@ -17,10 +28,121 @@ constexpr long bufsize = 256;
 constexpr long decimal = 10;
 constexpr long octal = 8;
 
+// allocation accounting, enabled at runtime with AOC_MEMSTAT=1
+constexpr long memstat_buckets = 64;
+constexpr long memstat_cache = 4096;
+constexpr long memstat_arenas = 16;
+typedef struct {
+    uintptr_t ptr;
+    long size;
+} MemstatEntry;
+typedef struct {
+    long capacity;
+    uintptr_t low;
+    uintptr_t high;
+} MemstatArena;
+typedef struct {
+    bool enabled;
+    pthread_once_t once;
+    pthread_mutex_t lock;
+    long count;
+    long reallocs;
+    long bytes;
+    long copied;
+    long histogram[memstat_buckets];
+    MemstatEntry cache[memstat_cache];
+    long arenas;
+    MemstatArena arena[memstat_arenas];
+} Memstat;
+Memstat memstat = {.once = PTHREAD_ONCE_INIT, .lock = PTHREAD_MUTEX_INITIALIZER};
+void memstat_report(void) {
+    fprintf(stderr, "memstat: %ld allocations (%ld reallocs), %ld bytes, %ld bytes copied\n",
+            memstat.count, memstat.reallocs, memstat.bytes, memstat.copied);
+    for (long i = 0; i < memstat.arenas; i++) {
+        const MemstatArena *arena = &memstat.arena[i];
+        fprintf(stderr, "memstat: %ld of %ld bytes arena high-water mark\n",
+                arena->high > arena->low ? (long)(arena->high - arena->low) : 0, arena->capacity);
+    }
+    for (long i = 0; i < memstat_buckets; i++) {
+        if (memstat.histogram[i]) {
+            fprintf(stderr, "memstat: %14ld B+ %12ld\n", 1L << i, memstat.histogram[i]);
+        }
+    }
+}
+void memstat_init(void) {
+    const char *env = getenv("AOC_MEMSTAT");
+    memstat.enabled = env && strcmp(env, "0");
+    if (memstat.enabled) {
+        atexit(memstat_report);
+    }
+}
+bool memstat_enabled(void) {
+    pthread_once(&memstat.once, memstat_init);
+    return memstat.enabled;
+}
+MemstatArena *memstat_arena(uintptr_t ptr) {
+    MemstatArena *fresh = nullptr;
+    for (long i = memstat.arenas - 1; i >= 0; i--) {
+        MemstatArena *arena = &memstat.arena[i];
+        if (arena->high < arena->low) {
+            fresh = fresh ? fresh : arena;
+        }
+        else if (arena->high - arena->capacity <= ptr && ptr < arena->low + arena->capacity) {
+            return arena;
+        }
+    }
+    return fresh;
+}
+void *memstat_record(void *ptr, long size, uintptr_t old) {
+    if (!memstat_enabled()) {
+        return ptr;
+    }
+    pthread_mutex_lock(&memstat.lock);
+    memstat.count += 1;
+    memstat.reallocs += old != 0;
+    memstat.bytes += size;
+    memstat.histogram[size ? 63 - __builtin_clzll(size) : 0] += 1;
+    MemstatArena *arena = memstat_arena((uintptr_t)ptr);
+    if (arena) {
+        arena->low = (uintptr_t)ptr < arena->low ? (uintptr_t)ptr : arena->low;
+        arena->high = (uintptr_t)ptr + size > arena->high ? (uintptr_t)ptr + size : arena->high;
+    }
+    if (old && old != (uintptr_t)ptr) {
+        MemstatEntry *prev = &memstat.cache[(old >> 4) % memstat_cache];
+        memstat.copied += prev->ptr == old && prev->size < size ? prev->size : size;
+    }
+    memstat.cache[((uintptr_t)ptr >> 4) % memstat_cache] = (MemstatEntry){(uintptr_t)ptr, size};
+    pthread_mutex_unlock(&memstat.lock);
+    return ptr;
+}
+Arena memstat_arena_create(long size) {
+    if (memstat_enabled()) {
+        pthread_mutex_lock(&memstat.lock);
+        if (memstat.arenas < memstat_arenas) {
+            memstat.arena[memstat.arenas++] = (MemstatArena){size, UINTPTR_MAX, 0};
+        }
+        pthread_mutex_unlock(&memstat.lock);
+    }
+    return arena_create(size);
+}
+void *memstat_calloc(Arena *arena, long n, long size, long align) {
+    return memstat_record(arena_calloc(arena, n, size, align), n * size, 0);
+}
+void *memstat_realloc(Arena *arena, void *ptr, long n, long size, long align) {
+    uintptr_t old = (uintptr_t)ptr;
+    return memstat_record(arena_realloc(arena, ptr, n, size, align), n * size, old);
+}
+void *memstat_memdup(Arena *arena, const void *ptr, long n, long size, long align) {
+    return memstat_record(arena_memdup(arena, ptr, n, size, align), n * size, 0);
+}
+
 // memory management
-#define calloc(A, P, N) arena_calloc(A, N, sizeof(*(P)), alignof(typeof(*(P))))
-#define realloc(A, P, N) arena_realloc(A, P, N, sizeof(*(P)), alignof(typeof(*(P))))
-#define memdup(A, P, N) arena_memdup(A, P, N, sizeof(*(P)), alignof(typeof(*(P))))
+#define arena_create(N) memstat_arena_create(N)
+#define calloc(A, P, N) memstat_calloc(A, N, sizeof(*(P)), alignof(typeof(*(P))))
+#define realloc(A, P, N) memstat_realloc(A, P, N, sizeof(*(P)), alignof(typeof(*(P))))
+#define memdup(A, P, N) memstat_memdup(A, P, N, sizeof(*(P)), alignof(typeof(*(P))))
+#define calloc_aligned(A, P, N, L) memstat_calloc(A, N, sizeof(*(P)), L)
+#define memdup_aligned(A, P, N, L) memstat_memdup(A, P, N, sizeof(*(P)), L)
 #define strdup(A, S) memdup(A, S, strlen(S) + 1)
 #define strapp(A, S1, S2) strcat(realloc(A, S1, strlen(S1) + strlen(S2) + 1), S2)
 
@@ -60,22 +182,77 @@ long lpow(long a, long b) {
 long lmod(long a, long b) {
     return ((a % b) + b) % b;
 }
+long popcount(uint64_t a) {
+    return __builtin_popcountll(a);
+}
+void print_u128(unsigned _BitInt(128) a) {
+    char str[bufsize] = "";
+    long length = 0;
+    do {
+        str[length++] = '0' + (char)(a % decimal);
+        a /= decimal;
+    } while (a);
+    while (length--) {
+        putchar(str[length]);
+    }
+    putchar('\n');
+}
+
+// thread functions, one thread per cpu the process may run on, limited with AOC_THREADS=n
+constexpr long max_threads = 64;
+long cpu_count(void) {
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set)) {
+        return sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    return CPU_COUNT(&set);
+}
+long thread_count(long jobs) {
+    const char *env = getenv("AOC_THREADS");
+    long count = env && *env ? strtol(env, nullptr, decimal) : cpu_count();
+    return lmax(1, lmin(lmin(count, max_threads), jobs));
+}
+void parallel_run(void *(*work)(void *), void *task, long count, long size) {
+    pthread_t thread[max_threads];
+    for (long i = 1; i < count; i++) {
+        int err = pthread_create(&thread[i], nullptr, work, (char *)task + (i * size));
+        assert(!err);
+    }
+    work(task);
+    for (long i = 1; i < count; i++) {
+        pthread_join(thread[i], nullptr);
+    }
+}
 
 // parse functions
+const char *input_path(const char *fname) {
+    const char *env = getenv("AOC_INPUT");
+    return env && *env ? env : fname;
+}
+long input_size(const char *fname) {
+    FILE *file = fopen(fname, "r");
+    assert(file);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+long input_arena(const char *fname, long base, long per_byte) {
+    return base + (per_byte * input_size(fname));
+}
 char *string_parse(const char *fname, const char *skip, Arena *arena) {
-    char *input = calloc(arena, input, 1);
+    long size = input_size(fname);
+    char *input = calloc(arena, input, size + 1);
     FILE *file = fopen(fname, "r");
     assert(file);
-    long n = 1;
+    long n = 0;
     int c;
-    while ((c = fgetc(file)) != EOF) {
+    while (n < size && (c = fgetc(file)) != EOF) {
         if (skip && strchr(skip, c)) {
             continue;
         }
-        input = realloc(arena, input, ++n);
-        input[n - 2] = c;
+        input[n++] = c;
     }
-    input[n - 1] = 0;
     fclose(file);
     return input;
 }
@@ -98,20 +275,24 @@ Grid grid_create(long rows, long cols, char chr, Arena *arena) {
 }
 Grid grid_parse(const char *fname, Arena *arena) {
     Grid grid = {};
-    grid.data = calloc(arena, grid.data, 1);
+    grid.data = calloc(arena, grid.data, input_size(fname) + 1);
     FILE *file = fopen(fname, "r");
     assert(file);
-    char line[bufsize];
-    while (fgets(line, sizeof(line), file)) {
-        *strchr(line, '\n') = 0;
-        if (line[0] == 0) {
+    char *line = nullptr;
+    size_t size = 0;
+    long length;
+    while ((length = getline(&line, &size, file)) > 0) {
+        if (line[length - 1] == '\n') {
+            line[--length] = 0;
+        }
+        if (length == 0) {
             break;
         }
+        memcpy(grid.data + (grid.rows * length), line, length);
         grid.rows += 1;
-        grid.cols = strlen(line);
-        grid.data = realloc(arena, grid.data, (grid.rows * grid.cols) + 1);
-        strncat(grid.data, line, grid.cols);
+        grid.cols = length;
     }
+    free(line);
     fclose(file);
     return grid;
 }
@@ -156,3 +337,81 @@ void grid_write(const Grid *grid, const char *path) {
     fwrite(grid->data, 1, grid->cols * grid->rows, file);
     fclose(file);
 }
+
+// profiling functions, enabled at runtime with AOC_PROFILE=1
+constexpr long profile_slots = 64;
+typedef struct {
+    const char *name;
+    long calls;
+    long count;
+    double seconds;
+} ProfileSlot;
+typedef struct {
+    int enabled;
+    long length;
+    ProfileSlot slot[profile_slots];
+} Profile;
+typedef struct {
+    const char *name;
+    bool active;
+    double start;
+} ProfileTimer;
+Profile profile_state = {.enabled = -1};
+#define profile(name) profile_block(name, profile_concat(profile_timer_, __LINE__))
+#define profile_block(name, T) \
+    for (ProfileTimer T = profile_start(name); T.active; profile_stop(&T))
+#define profile_concat(a, b) profile_concat_(a, b)
+#define profile_concat_(a, b) a##b
+double profile_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+void profile_report(void) {
+    fprintf(stderr, "%-24s %10s %12s %14s\n", "phase", "calls", "time [ms]", "count");
+    for (long i = 0; i < profile_state.length; i++) {
+        const ProfileSlot *slot = &profile_state.slot[i];
+        fprintf(stderr, "%-24s %10ld %12.3f %14ld\n", slot->name, slot->calls, 1e3 * slot->seconds,
+                slot->count);
+    }
+}
+bool profile_enabled(void) {
+    if (profile_state.enabled < 0) {
+        const char *env = getenv("AOC_PROFILE");
+        profile_state.enabled = env && strcmp(env, "0");
+        if (profile_state.enabled) {
+            atexit(profile_report);
+        }
+    }
+    return profile_state.enabled;
+}
+ProfileSlot *profile_slot(const char *name) {
+    for (long i = 0; i < profile_state.length; i++) {
+        if (profile_state.slot[i].name == name || !strcmp(profile_state.slot[i].name, name)) {
+            return &profile_state.slot[i];
+        }
+    }
+    assert(profile_state.length < profile_slots);
+    ProfileSlot *slot = &profile_state.slot[profile_state.length++];
+    slot->name = name;
+    return slot;
+}
+ProfileTimer profile_start(const char *name) {
+    if (!profile_enabled()) {
+        return (ProfileTimer){.active = true};
+    }
+    return (ProfileTimer){name, true, profile_clock()};
+}
+void profile_stop(ProfileTimer *timer) {
+    if (timer->name) {
+        ProfileSlot *slot = profile_slot(timer->name);
+        slot->calls += 1;
+        slot->seconds += profile_clock() - timer->start;
+    }
+    timer->active = false;
+}
+void profile_count(const char *name, long count) {
+    if (profile_enabled()) {
+        profile_slot(name)->count += count;
+    }
+}
@@ -0,0 +1,199 @@
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    double min;
+    double median;
+    double p95;
+} Stats;
+
+typedef struct {
+    const char *name;
+    Stats wall;
+    double user;
+    double sys;
+    long rss;
+} Result;
+
+void usage(const char *prog);
+void run(const char *prog, double *wall, double *user, double *sys, long *rss);
+Stats stats(double *sample, long runs);
+void write_json(const Result *result, long count, const char *fname);
+int cmp_result(const void *_a, const void *_b);
+long compare(const Result *result, long count, const char *fname, double threshold);
+
+int main(int argc, char **argv) {
+    long runs = 10;
+    long warmup = 1;
+    const char *output = nullptr;
+    const char *baseline = nullptr;
+    double threshold = 0.1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:w:o:b:t:")) != -1) {
+        switch (opt) {
+            case 'n': runs = strtol(optarg, nullptr, 10); break;
+            case 'w': warmup = strtol(optarg, nullptr, 10); break;
+            case 'o': output = optarg; break;
+            case 'b': baseline = optarg; break;
+            case 't': threshold = strtod(optarg, nullptr); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (optind == argc || runs < 1) {
+        usage(argv[0]);
+    }
+
+    long count = argc - optind;
+    Result *result = calloc(count, sizeof(*result));
+    double *wall = calloc(4 * runs, sizeof(*wall));
+    double *user = wall + runs;
+    double *sys = user + runs;
+    double *tmp = sys + runs;
+    assert(result && wall);
+    for (long i = 0; i < count; i++) {
+        const char *prog = argv[optind + i];
+        long rss = 0;
+        for (long j = 0; j < warmup; j++) {
+            run(prog, &tmp[0], &tmp[1], &tmp[2], &rss);
+        }
+        rss = 0;
+        for (long j = 0; j < runs; j++) {
+            run(prog, &wall[j], &user[j], &sys[j], &rss);
+        }
+        result[i] = (Result){.name = prog, .wall = stats(wall, runs), .rss = rss};
+        result[i].user = stats(user, runs).median;
+        result[i].sys = stats(sys, runs).median;
+        fprintf(stderr, "%s\n", prog);
+    }
+
+    if (output) {
+        write_json(result, count, output);
+    }
+    qsort(result, count, sizeof(*result), cmp_result);
+    printf("%-10s %10s %10s %10s %10s %10s %10s\n", "day", "median", "p95", "min", "user",
+           "sys", "rss");
+    double total = 0;
+    for (long i = 0; i < count; i++) {
+        const Result *r = &result[i];
+        printf("%-10s %10.3f %10.3f %10.3f %10.3f %10.3f %8ld kB\n", r->name, 1e3 * r->wall.median,
+               1e3 * r->wall.p95, 1e3 * r->wall.min, 1e3 * r->user, 1e3 * r->sys, r->rss);
+        total += r->wall.median;
+    }
+    printf("%-10s %10.3f (ms)\n", "total", 1e3 * total);
+
+    long regressions = baseline ? compare(result, count, baseline, threshold) : 0;
+
+    free(wall);
+    free(result);
+    return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-n runs] [-w warmup] [-o out.json] [-b base.json] [-t threshold] "
+                    "prog...\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+double seconds(const struct timeval *tv) {
+    return tv->tv_sec + (tv->tv_usec * 1e-6);
+}
+
+void run(const char *prog, double *wall, double *user, double *sys, long *rss) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        char path[4096];
+        snprintf(path, sizeof(path), "./%s", prog);
+        execl(path, path, (char *)nullptr);
+        _exit(127);
+    }
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+        fprintf(stderr, "%s: exited abnormally\n", prog);
+    }
+    *wall = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) * 1e-9);
+    *user = seconds(&usage.ru_utime);
+    *sys = seconds(&usage.ru_stime);
+    *rss = usage.ru_maxrss > *rss ? usage.ru_maxrss : *rss;
+}
+
+int cmp_double(const void *_a, const void *_b) {
+    double a = *(const double *)_a;
+    double b = *(const double *)_b;
+    return (a > b) - (a < b);
+}
+
+Stats stats(double *sample, long runs) {
+    qsort(sample, runs, sizeof(*sample), cmp_double);
+    long p95 = ((95 * runs) + 99) / 100 - 1;
+    return (Stats){sample[0], sample[runs / 2], sample[p95]};
+}
+
+void write_json(const Result *result, long count, const char *fname) {
+    FILE *file = fopen(fname, "w");
+    assert(file);
+    fprintf(file, "{\n");
+    for (long i = 0; i < count; i++) {
+        const Result *r = &result[i];
+        fprintf(file,
+                "  \"%s\": {\"min\": %.6f, \"median\": %.6f, \"p95\": %.6f, \"user\": %.6f, "
+                "\"sys\": %.6f, \"rss\": %ld}%s\n",
+                r->name, r->wall.min, r->wall.median, r->wall.p95, r->user, r->sys, r->rss,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(file, "}\n");
+    fclose(file);
+}
+
+int cmp_result(const void *_a, const void *_b) {
+    const Result *a = _a;
+    const Result *b = _b;
+    return cmp_double(&b->wall.median, &a->wall.median);
+}
+
+long compare(const Result *result, long count, const char *fname, double threshold) {
+    FILE *file = fopen(fname, "r");
+    if (!file) {
+        fprintf(stderr, "%s: cannot open baseline\n", fname);
+        return 1;
+    }
+    long regressions = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        char name[256];
+        double median;
+        if (sscanf(line, " \"%255[^\"]\": {\"min\": %*f, \"median\": %lf", name, &median) != 2) {
+            continue;
+        }
+        for (long i = 0; i < count; i++) {
+            if (strcmp(result[i].name, name)) {
+                continue;
+            }
+            double ratio = result[i].wall.median / median;
+            if (ratio > 1 + threshold) {
+                printf("REGRESSION %-10s %10.3f -> %10.3f ms (%+.1f%%)\n", name, 1e3 * median,
+                       1e3 * result[i].wall.median, 100 * (ratio - 1));
+                regressions += 1;
+            }
+        }
+    }
+    fclose(file);
+    return regressions;
+}
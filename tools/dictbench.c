@@ -0,0 +1,97 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+
+#include "../2021/dict.h"
+
+#if DICT_HASH == DICT_HASH_FNV1A
+#define HASH_NAME "fnv1a"
+#else
+#define HASH_NAME "wymum"
+#endif
+
+#define KEY_SIZE 128
+
+typedef void Shape(char *key, size_t i);
+
+void coord(char *key, size_t i);
+void state(char *key, size_t i);
+double now(void);
+void bench(const char *name, Shape *shape, size_t n);
+
+int main(int argc, char **argv) {
+    const size_t n = argc > 1 ? strtoul(argv[1], 0, 10) : 1000000;
+    bench("coord", coord, n);
+    bench("state", state, n);
+}
+
+// short keys like the grid positions most puzzles use
+void coord(char *key, size_t i) {
+    snprintf(key, KEY_SIZE, "%zu,%zu", i % 1000, i / 1000);
+}
+
+// long keys like the search states of 2022/19
+void state(char *key, size_t i) {
+    snprintf(key, KEY_SIZE, "%zu %zu %zu %zu %zu %zu %zu %zu %zu ", i % 24, i % 5, i % 7, i % 3,
+             i % 11, i / 3, i / 7, i / 11, i / 13);
+}
+
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void bench(const char *name, Shape *shape, size_t n) {
+    // create keys, the second half is only used for misses
+    char(*key)[KEY_SIZE] = malloc(2 * n * sizeof(*key));
+    for (size_t i = 0; i < 2 * n; ++i) {
+        shape(key[i], i);
+    }
+
+    // shuffle keys so that sequential key patterns cannot fake cache locality
+    uint64_t seed = 1;
+    for (size_t i = 2 * n - 1; i > 0; --i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const size_t j = (seed >> 33) % (i + 1);
+        char tmp[KEY_SIZE];
+        memcpy(tmp, key[i], KEY_SIZE);
+        memcpy(key[i], key[j], KEY_SIZE);
+        memcpy(key[j], tmp, KEY_SIZE);
+    }
+
+    // time insert, successful and unsuccessful find
+    Dict *dict = dict_alloc(0, n);
+    double t0 = now();
+    for (size_t i = 0; i < n; ++i) {
+        dict_insert(dict, key[i], 0);
+    }
+    double t1 = now();
+    size_t found = 0;
+    for (size_t i = 0; i < n; ++i) {
+        found += dict_find(dict, key[i]) != 0;
+    }
+    double t2 = now();
+    for (size_t i = n; i < 2 * n; ++i) {
+        found += dict_find(dict, key[i]) != 0;
+    }
+    double t3 = now();
+    assert(found == n);
+
+    // expected number of key comparisons for a successful find
+    size_t probes = 0;
+    for (size_t i = 0; i < dict->size; ++i) {
+        size_t len = 0;
+        for (const Item *item = &dict->item[i]; item && item->key; item = item->next) {
+            probes += ++len;
+        }
+    }
+
+    printf("%s %s: insert %.1f ns, hit %.1f ns, miss %.1f ns, %.3f probes per hit\n", HASH_NAME,
+           name, 1e9 * (t1 - t0) / n, 1e9 * (t2 - t1) / n, 1e9 * (t3 - t2) / n,
+           (double)probes / dict->len);
+    dict_histogram(dict);
+
+    dict_free(&dict, 0);
+    free(key);
+}
@@ -0,0 +1,559 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct Preset Preset;
+typedef void Family(const Preset *preset, double scale);
+
+struct Preset {
+    const char *day;
+    Family *family;
+    long size;              // lines, cells, or bytes at scale 1
+    long bytes;             // approximate output size at scale 1
+    long count[2];          // numbers per line, file lengths of a disk map, or moves and per line
+    long range[2];          // number values, free lengths of a disk map, or pattern lengths
+    long group;             // maximum lines per blank-line separated group
+    const char *alphabet;   // grid or maze letters, towel colors, or number separator
+    const char *token[16];  // text fragments
+    const char *format;     // record layout
+    long field[4][2];       // record number ranges
+    bool board;             // record fields are coordinates on a board
+    long items;             // towel patterns, or adder bits at scale 1
+};
+
+static uint64_t state = 1;
+static bool grow = false;
+
+void usage(const char *prog);
+uint64_t next(void);
+long uniform(long lo, long hi);
+void numbers(const Preset *preset, double scale);
+void grid(const Preset *preset, double scale);
+void text(const Preset *preset, double scale);
+void diskmap(const Preset *preset, double scale);
+void records(const Preset *preset, double scale);
+void equations(const Preset *preset, double scale);
+void edges(const Preset *preset, double scale);
+void maze(const Preset *preset, double scale);
+void warehouse(const Preset *preset, double scale);
+void program(const Preset *preset, double scale);
+void towels(const Preset *preset, double scale);
+void adder(const Preset *preset, double scale);
+void shuffle(long *item, long length);
+long quine(const long *digit, long i, long a, const long *k);
+void wire(char *name, bool *used);
+void connect(char *gate, const char *a, const char *op, const char *b);
+
+static const Preset table[] = {
+    {"2021/01", numbers, 2000, 9790, .count = {1, 1}, .range = {100, 10000}},
+    {"2022/01", numbers, 2250, 13500, .count = {1, 1}, .range = {1000, 70000}, .group = 15},
+    {"2024/01", numbers, 1000, 14000, .count = {2, 2}, .range = {10000, 99999}, .alphabet = "   "},
+    {"2024/02", numbers, 1000, 18900, .count = {5, 8}, .range = {1, 99}},
+    {"2024/03", text, 18000, 18000,
+     .token = {"mul(", ",", ")", "do()", "don't()", "1", "23", "456", "x", "m", "d", "[",
+               "mul(2,4)", "mu"}},
+    {"2024/04", grid, 19600, 19740, .alphabet = "XMAS"},
+    {"2024/05", edges, 200, 16270, .count = {5, 23}, .range = {11, 59}},
+    {"2024/07", equations, 850, 35570, .count = {3, 12}, .range = {1, 999}},
+    {"2024/09", diskmap, 19999, 20000, .count = {1, 9}, .range = {0, 9}},
+    {"2024/10", grid, 2916, 2970, .alphabet = "0123456789"},
+    {"2024/12", grid, 19600, 19740, .alphabet = "ABCDEFGH"},
+    {"2024/14", records, 500, 8330, .format = "p=%ld,%ld v=%ld,%ld\n",
+     .field = {{0, 100}, {0, 102}, {-100, 100}, {-102, 102}}, .board = true},
+    {"2024/15", warehouse, 2500, 22570, .count = {20000, 1000}, .alphabet = "......OOO#"},
+    {"2024/16", maze, 19881, 20022, .alphabet = "#.SE"},
+    {"2024/17", program, 1, 100, .range = {1, 7}},
+    {"2024/18", records, 3450, 19740, .format = "%ld,%ld\n", .field = {{0, 70}, {0, 70}},
+     .board = true},
+    {"2024/19", towels, 400, 20960, .count = {20, 60}, .range = {1, 8}, .alphabet = "wubrg",
+     .items = 447},
+    {"2024/22", numbers, 2000, 16660, .count = {1, 1}, .range = {1, 16777215}},
+    {"2024/24", adder, 1, 4800, .items = 45},
+};
+
+int main(int argc, char **argv) {
+    double scale = 1;
+    double bytes = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:x:b:g")) != -1) {
+        switch (opt) {
+            case 's': state = strtoull(optarg, nullptr, 10); break;
+            case 'x': scale = strtod(optarg, nullptr); break;
+            case 'b': bytes = strtod(optarg, nullptr); break;
+            case 'g': grow = true; break;
+            default: usage(argv[0]);
+        }
+    }
+    if (optind + 1 != argc) {
+        usage(argv[0]);
+    }
+    for (size_t i = 0; i < sizeof(table) / sizeof(*table); i++) {
+        if (!strcmp(table[i].day, argv[optind])) {
+            table[i].family(&table[i], bytes > 0 ? bytes / table[i].bytes : scale);
+            return EXIT_SUCCESS;
+        }
+    }
+    usage(argv[0]);
+}
+
+void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-s seed] [-x scale | -b bytes] [-g] <year>/<day>\n", prog);
+    fprintf(stderr, "days:");
+    for (size_t i = 0; i < sizeof(table) / sizeof(*table); i++) {
+        fprintf(stderr, " %s", table[i].day);
+    }
+    fprintf(stderr, "\n-g grows the board of 2024/14 and 2024/18 with the scale\n");
+    exit(EXIT_FAILURE);
+}
+
+// splitmix64, so that a seed always produces the same input
+uint64_t next(void) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+long uniform(long lo, long hi) {
+    return lo + (long)(next() % (uint64_t)(hi - lo + 1));
+}
+
+void shuffle(long *item, long length) {
+    for (long i = length - 1; i > 0; i--) {
+        long j = uniform(0, i);
+        long tmp = item[i];
+        item[i] = item[j];
+        item[j] = tmp;
+    }
+}
+
+// lines of numbers, optionally in groups separated by blank lines
+void numbers(const Preset *preset, double scale) {
+    long lines = lround(preset->size * scale);
+    const char *sep = preset->alphabet ? preset->alphabet : " ";
+    long group = preset->group ? uniform(1, preset->group) : 0;
+    for (long i = 0; i < lines; i++) {
+        long count = uniform(preset->count[0], preset->count[1]);
+        for (long j = 0; j < count; j++) {
+            printf("%s%ld", j ? sep : "", uniform(preset->range[0], preset->range[1]));
+        }
+        printf("\n");
+        if (preset->group && --group == 0 && i + 1 < lines) {
+            printf("\n");
+            group = uniform(1, preset->group);
+        }
+    }
+}
+
+// square grid of random letters with the cell count scaled
+void grid(const Preset *preset, double scale) {
+    long side = lround(sqrt(preset->size * scale));
+    long letters = strlen(preset->alphabet);
+    for (long r = 0; r < side; r++) {
+        for (long c = 0; c < side; c++) {
+            putchar(preset->alphabet[uniform(0, letters - 1)]);
+        }
+        putchar('\n');
+    }
+}
+
+// random concatenation of text fragments, broken into lines
+void text(const Preset *preset, double scale) {
+    long bytes = lround(preset->size * scale);
+    long tokens = 0;
+    while (tokens < 16 && preset->token[tokens]) {
+        tokens += 1;
+    }
+    long line = 0;
+    for (long n = 0; n < bytes;) {
+        const char *token = preset->token[uniform(0, tokens - 1)];
+        fputs(token, stdout);
+        n += strlen(token);
+        line += strlen(token);
+        if (line > 3000) {
+            putchar('\n');
+            line = 0;
+        }
+    }
+    putchar('\n');
+}
+
+// one line of digits, alternating file and free lengths, ending with a file
+void diskmap(const Preset *preset, double scale) {
+    long length = lround(preset->size * scale) | 1;
+    for (long i = 0; i < length; i++) {
+        const long *range = i % 2 ? preset->range : preset->count;
+        putchar('0' + uniform(range[0], range[1]));
+    }
+    putchar('\n');
+}
+
+// lines of formatted numbers, with board coordinates grown by the square root of the scale
+void records(const Preset *preset, double scale) {
+    long lines = lround(preset->size * scale);
+    double side = preset->board && grow ? sqrt(scale) : 1;
+    long field[4][2];
+    for (long j = 0; j < 4; j++) {
+        field[j][0] = lround(preset->field[j][0] * side);
+        field[j][1] = lround(preset->field[j][1] * side);
+    }
+    if (preset->board && grow) {
+        fprintf(stderr, "board %ldx%ld\n", field[0][1] + 1, field[1][1] + 1);
+    }
+    for (long i = 0; i < lines; i++) {
+        long value[4];
+        for (long j = 0; j < 4; j++) {
+            value[j] = uniform(field[j][0], field[j][1]);
+        }
+        printf(preset->format, value[0], value[1], value[2], value[3]);
+    }
+}
+
+// totals of the numbers that follow under random +, *, and ||, half of them off by one
+void equations(const Preset *preset, double scale) {
+    constexpr long limit = 10000000000000;
+    long lines = lround(preset->size * scale);
+    for (long i = 0; i < lines; i++) {
+        long count = uniform(preset->count[0], preset->count[1]);
+        long number[16];
+        long total = 0;
+        for (long j = 0; j < count; j++) {
+            number[j] = uniform(preset->range[0], preset->range[1]);
+            long width = 1;
+            for (long v = number[j]; v; v /= 10) {
+                width *= 10;
+            }
+            long op = j ? uniform(0, 2) : 0;
+            if (op == 2 && total < limit / width) {
+                total = (total * width) + number[j];
+            }
+            else if (op == 1 && total < limit / number[j]) {
+                total *= number[j];
+            }
+            else {
+                total += number[j];
+            }
+        }
+        printf("%ld:", total + uniform(0, 1));
+        for (long j = 0; j < count; j++) {
+            printf(" %ld", number[j]);
+        }
+        printf("\n");
+    }
+}
+
+// edge list of a total order on the pages, then odd-length updates that follow it or not
+void edges(const Preset *preset, double scale) {
+    long lines = lround(preset->size * scale);
+    long pages = preset->range[1] - preset->range[0] + 1;
+    long *page = malloc(sizeof(*page) * pages);
+    long *rank = malloc(sizeof(*rank) * pages);
+    long *rule = malloc(sizeof(*rule) * pages * pages);
+    for (long i = 0; i < pages; i++) {
+        page[i] = i;
+    }
+    shuffle(page, pages);
+    long rules = 0;
+    for (long i = 0; i < pages; i++) {
+        rank[page[i]] = i;
+        for (long j = i + 1; j < pages; j++) {
+            rule[rules++] = (page[i] * pages) + page[j];
+        }
+    }
+    shuffle(rule, rules);
+    for (long i = 0; i < rules; i++) {
+        long a = rule[i] / pages;
+        long b = rule[i] % pages;
+        printf("%ld|%ld\n", preset->range[0] + a, preset->range[0] + b);
+    }
+    printf("\n");
+    for (long i = 0; i < lines; i++) {
+        long count = uniform(preset->count[0], preset->count[1]) | 1;
+        for (long j = 0; j < count; j++) {
+            long k = uniform(j, pages - 1);
+            long tmp = page[j];
+            page[j] = page[k];
+            page[k] = tmp;
+        }
+        bool ordered = uniform(0, 1);
+        for (long j = 1; ordered && j < count; j++) {
+            for (long k = j; k > 0 && rank[page[k - 1]] > rank[page[k]]; k--) {
+                long tmp = page[k];
+                page[k] = page[k - 1];
+                page[k - 1] = tmp;
+            }
+        }
+        for (long j = 0; j < count; j++) {
+            printf("%s%ld", j ? "," : "", preset->range[0] + page[j]);
+        }
+        printf("\n");
+    }
+    free(page);
+    free(rank);
+    free(rule);
+}
+
+// perfect maze carved between odd cells and opened up with loops, S bottom left, E top right
+void maze(const Preset *preset, double scale) {
+    long side = lround(sqrt(preset->size * scale)) | 1;
+    side = side < 5 ? 5 : side;
+    char *cell = malloc(side * side);
+    memset(cell, preset->alphabet[0], side * side);
+    long *stack = malloc(sizeof(*stack) * side * side);
+    const long dr[4] = {-2, 0, 2, 0};
+    const long dc[4] = {0, 2, 0, -2};
+    long start = ((side - 2) * side) + 1;
+    long length = 0;
+    cell[start] = preset->alphabet[1];
+    stack[length++] = start;
+    while (length) {
+        long r = stack[length - 1] / side;
+        long c = stack[length - 1] % side;
+        long open[4];
+        long count = 0;
+        for (long k = 0; k < 4; k++) {
+            long nr = r + dr[k];
+            long nc = c + dc[k];
+            bool inside = nr > 0 && nr < side - 1 && nc > 0 && nc < side - 1;
+            if (inside && cell[(nr * side) + nc] == preset->alphabet[0]) {
+                open[count++] = k;
+            }
+        }
+        if (!count) {
+            length -= 1;
+            continue;
+        }
+        long k = open[uniform(0, count - 1)];
+        cell[((r + (dr[k] / 2)) * side) + c + (dc[k] / 2)] = preset->alphabet[1];
+        cell[((r + dr[k]) * side) + c + dc[k]] = preset->alphabet[1];
+        stack[length++] = ((r + dr[k]) * side) + c + dc[k];
+    }
+    for (long i = 0; i < side * side / 32; i++) {
+        long r = uniform(1, side - 2);
+        long c = uniform(1, side - 2);
+        if ((r + c) % 2) {
+            cell[(r * side) + c] = preset->alphabet[1];
+        }
+    }
+    cell[start] = preset->alphabet[2];
+    cell[side + side - 2] = preset->alphabet[3];
+    for (long r = 0; r < side; r++) {
+        fwrite(cell + (r * side), 1, side, stdout);
+        putchar('\n');
+    }
+    free(cell);
+    free(stack);
+}
+
+// walled map of boxes and walls around a robot in the middle, then lines of moves
+void warehouse(const Preset *preset, double scale) {
+    long side = lround(sqrt(preset->size * scale));
+    side = side < 4 ? 4 : side;
+    long letters = strlen(preset->alphabet);
+    for (long r = 0; r < side; r++) {
+        for (long c = 0; c < side; c++) {
+            if (r == 0 || c == 0 || r == side - 1 || c == side - 1) {
+                putchar('#');
+            }
+            else if (r == side / 2 && c == side / 2) {
+                putchar('@');
+            }
+            else {
+                putchar(preset->alphabet[uniform(0, letters - 1)]);
+            }
+        }
+        putchar('\n');
+    }
+    putchar('\n');
+    long moves = lround(preset->count[0] * scale);
+    for (long i = 0; i < moves; i++) {
+        putchar("<>^v"[uniform(0, 3)]);
+        if ((i + 1) % preset->count[1] == 0 || i + 1 == moves) {
+            putchar('\n');
+        }
+    }
+}
+
+// loop that prints one octal digit of A per pass through random xor constants, redrawn until
+// the program can print itself; independent of the scale since the register is 64 bits wide
+void program(const Preset *preset, double) {
+    long digit[16] = {2, 4, 1, 0, 7, 5, 1, 0, 4, 0, 0, 3, 5, 5, 3, 0};
+    long k[2];
+    do {
+        k[0] = uniform(preset->range[0], preset->range[1]);
+        k[1] = uniform(preset->range[0], preset->range[1]);
+        digit[3] = k[0];
+        long order = uniform(0, 1);
+        digit[6 + (2 * order)] = 1;
+        digit[7 + (2 * order)] = k[1];
+        digit[8 - (2 * order)] = 4;
+        digit[9 - (2 * order)] = uniform(0, 7);
+    } while (quine(digit, 15, 0, k) < 0);
+    printf("Register A: %ld\nRegister B: 0\nRegister C: 0\n\n", uniform(1L << 45, (1L << 48) - 1));
+    printf("Program: ");
+    for (long i = 0; i < 16; i++) {
+        printf("%ld%c", digit[i], i < 15 ? ',' : '\n');
+    }
+}
+
+// smallest A that prints digits 0 to i of the program after a, or -1
+long quine(const long *digit, long i, long a, const long *k) {
+    if (i < 0) {
+        return a;
+    }
+    for (long t = 0; t < 8; t++) {
+        long next = (a * 8) + t;
+        long b = t ^ k[0];
+        if (next && ((b ^ k[1] ^ (next >> b)) & 7) == digit[i]) {
+            long found = quine(digit, i - 1, next, k);
+            if (found >= 0) {
+                return found;
+            }
+        }
+    }
+    return -1;
+}
+
+// distinct patterns, none ending in the last color, then designs joined from them, a quarter
+// made impossible by ending in it
+void towels(const Preset *preset, double scale) {
+    long lines = lround(preset->size * scale);
+    long colors = strlen(preset->alphabet);
+    char last = preset->alphabet[colors - 1];
+    char (*pattern)[16] = calloc(preset->items, sizeof(*pattern));
+    for (long i = 0; i < preset->items;) {
+        long length = uniform(preset->range[0], preset->range[1]);
+        for (long j = 0; j < length; j++) {
+            pattern[i][j] = preset->alphabet[uniform(0, colors - 1)];
+        }
+        pattern[i][length] = 0;
+        bool fresh = pattern[i][length - 1] != last;
+        for (long j = 0; fresh && j < i; j++) {
+            fresh = strcmp(pattern[i], pattern[j]) != 0;
+        }
+        i += fresh;
+    }
+    for (long i = 0; i < preset->items; i++) {
+        printf("%s%s", i ? ", " : "", pattern[i]);
+    }
+    printf("\n\n");
+    for (long i = 0; i < lines; i++) {
+        char design[128];
+        long length = 0;
+        long target = uniform(preset->count[0], preset->count[1]);
+        while (length < target) {
+            const char *p = pattern[uniform(0, preset->items - 1)];
+            memcpy(design + length, p, strlen(p));
+            length += strlen(p);
+        }
+        design[length] = 0;
+        if (uniform(0, 3) == 0) {
+            design[length - 1] = last;
+        }
+        printf("%s\n", design);
+    }
+    free(pattern);
+}
+
+void wire(char *name, bool *used) {
+    long id;
+    do {
+        id = (uniform(0, 22) * 26 * 26) + uniform(0, (26 * 26) - 1);
+    } while (used[id]);
+    used[id] = true;
+    snprintf(name, 8, "%c%c%c", (char)('a' + (id / 26 / 26)), (char)('a' + (id / 26 % 26)),
+             (char)('a' + (id % 26)));
+}
+
+void connect(char *gate, const char *a, const char *op, const char *b) {
+    bool flip = uniform(0, 1);
+    snprintf(gate, 32, "%s %s %s", flip ? b : a, op, flip ? a : b);
+}
+
+// ripple-carry adder of x and y into z, with the outputs of four gate pairs swapped in distinct
+// bits, grown up to the 62 bits that keep z within a long
+void adder(const Preset *preset, double scale) {
+    long bits = lround(preset->items * scale);
+    bits = bits < 16 ? 16 : bits > 62 ? 62 : bits;
+    char (*gate)[32] = calloc(5 * bits, sizeof(*gate));
+    char (*out)[8] = calloc(5 * bits, sizeof(*out));
+    long (*index)[5] = calloc(bits, sizeof(*index));
+    bool *used = calloc(26 * 26 * 26, sizeof(*used));
+    char x[8];
+    char y[8];
+    char carry[8];
+    long gates = 0;
+    connect(gate[gates], "x00", "XOR", "y00");
+    snprintf(out[gates++], 8, "z00");
+    connect(gate[gates], "x00", "AND", "y00");
+    wire(out[gates++], used);
+    strcpy(carry, out[gates - 1]);
+    for (long i = 1; i < bits; i++) {
+        snprintf(x, sizeof(x), "x%02ld", i);
+        snprintf(y, sizeof(y), "y%02ld", i);
+        long *bit = index[i];
+        for (long k = 0; k < 5; k++) {
+            bit[k] = gates + k;
+        }
+        connect(gate[bit[0]], x, "XOR", y);
+        wire(out[bit[0]], used);
+        connect(gate[bit[1]], out[bit[0]], "XOR", carry);
+        snprintf(out[bit[1]], 8, "z%02ld", i);
+        connect(gate[bit[2]], x, "AND", y);
+        wire(out[bit[2]], used);
+        connect(gate[bit[3]], out[bit[0]], "AND", carry);
+        wire(out[bit[3]], used);
+        connect(gate[bit[4]], out[bit[2]], "OR", out[bit[3]]);
+        if (i + 1 < bits) {
+            wire(out[bit[4]], used);
+        }
+        else {
+            snprintf(out[bit[4]], 8, "z%02ld", bits);
+        }
+        strcpy(carry, out[bit[4]]);
+        gates += 5;
+    }
+
+    long swap[4][2] = {{1, 4}, {1, 3}, {1, 2}, {0, 2}};
+    long chosen[4];
+    for (long k = 0; k < 4; k++) {
+        bool apart;
+        do {
+            chosen[k] = uniform(2, bits - 2);
+            apart = true;
+            for (long j = 0; j < k; j++) {
+                apart = apart && labs(chosen[k] - chosen[j]) > 2;
+            }
+        } while (!apart);
+        char tmp[8];
+        char *a = out[index[chosen[k]][swap[k][0]]];
+        char *b = out[index[chosen[k]][swap[k][1]]];
+        memcpy(tmp, a, sizeof(tmp));
+        memcpy(a, b, sizeof(tmp));
+        memcpy(b, tmp, sizeof(tmp));
+    }
+
+    for (long i = 0; i < bits; i++) {
+        printf("x%02ld: %ld\n", i, uniform(0, 1));
+    }
+    for (long i = 0; i < bits; i++) {
+        printf("y%02ld: %ld\n", i, uniform(0, 1));
+    }
+    printf("\n");
+    long *order = malloc(sizeof(*order) * gates);
+    for (long i = 0; i < gates; i++) {
+        order[i] = i;
+    }
+    shuffle(order, gates);
+    for (long i = 0; i < gates; i++) {
+        printf("%s -> %s\n", gate[order[i]], out[order[i]]);
+    }
+    free(gate);
+    free(out);
+    free(index);
+    free(used);
+    free(order);
+}
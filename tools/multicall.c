@@ -0,0 +1,156 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// every puzzle main, renamed to day_<year>_<day> by the Makefile, days.h lists those taking
+// arguments as DAY and those taking none as DAY_VOID, which get a wrapper with the common signature
+#define DAY(id) int day_##id(int, char **);
+#define DAY_VOID(id)                                   \
+    int day_##id(void);                                   \
+    static int call_##id(int argc, char **argv) {         \
+        (void)argc;                                       \
+        (void)argv;                                       \
+        return day_##id();                                \
+    }
+#include "days.h"
+#undef DAY
+#undef DAY_VOID
+
+typedef struct {
+    char name[8];
+    int (*main)(int, char **);
+} Day;
+
+typedef struct {
+    char *name;
+    char *data;
+    long size;
+} Input;
+
+static Day day[] = {
+#define DAY(id) {#id, day_##id},
+#define DAY_VOID(id) {#id, call_##id},
+#include "days.h"
+#undef DAY
+#undef DAY_VOID
+};
+
+static Input *input;
+static long inputs;
+
+void usage(const char *prog);
+Day *day_find(const char *name);
+void preload(void);
+double run_all(void);
+
+int main(int argc, char **argv) {
+    for (size_t i = 0; i < sizeof(day) / sizeof(*day); i++) {
+        day[i].name[4] = '/';
+    }
+
+    char *prog = basename(strdup(argv[0]));
+    Day *d = day_find(prog);
+    if (d) {
+        return d->main(argc, argv);
+    }
+    if (argc > 2 && !strcmp(argv[1], "--day")) {
+        d = day_find(argv[2]);
+        if (!d) {
+            usage(argv[0]);
+        }
+        return d->main(argc - 2, argv + 2);
+    }
+    if (argc > 1 && !strcmp(argv[1], "all")) {
+        preload();
+        double seconds = run_all();
+        fprintf(stderr, "%-10s %10.3f ms\n", "total", 1e3 * seconds);
+        return EXIT_SUCCESS;
+    }
+    usage(argv[0]);
+}
+
+void usage(const char *prog) {
+    fprintf(stderr, "usage: %s --day <year>/<day> [args...] | all\n", prog);
+    fprintf(stderr, "   or: link as <year>_<day> and run it directly\n");
+    exit(EXIT_FAILURE);
+}
+
+Day *day_find(const char *name) {
+    if (strlen(name) != 7) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < sizeof(day) / sizeof(*day); i++) {
+        if (!strncmp(day[i].name, name, 4) && !strcmp(day[i].name + 5, name + 5)) {
+            return &day[i];
+        }
+    }
+    return nullptr;
+}
+
+void preload(void) {
+    inputs = sizeof(day) / sizeof(*day);
+    input = calloc(inputs, sizeof(*input));
+    assert(input);
+    for (long i = 0; i < inputs; i++) {
+        char fname[32];
+        snprintf(fname, sizeof(fname), "%.4s/input/%s.txt", day[i].name, day[i].name + 5);
+        input[i].name = strdup(fname);
+        FILE *file = fopen(fname, "r");
+        if (!file) {
+            continue;
+        }
+        fseek(file, 0, SEEK_END);
+        input[i].size = ftell(file);
+        rewind(file);
+        input[i].data = malloc(input[i].size + 1);
+        assert(input[i].data);
+        input[i].size = fread(input[i].data, 1, input[i].size, file);
+        fclose(file);
+    }
+}
+
+// every fopen of the puzzles goes through here, reads of preloaded inputs are served from memory
+FILE *aoc_fopen(const char *restrict fname, const char *restrict mode) {
+    if (mode[0] == 'r') {
+        for (long i = 0; i < inputs; i++) {
+            if (input[i].size > 0 && !strcmp(input[i].name, fname)) {
+                return fmemopen(input[i].data, input[i].size, mode);
+            }
+        }
+    }
+    return fopen(fname, mode);
+}
+
+double elapsed(const struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) + ((end.tv_nsec - start->tv_nsec) * 1e-9);
+}
+
+// days without their default input are skipped, and each runs with its defaults as if invoked
+// by name alone
+double run_all(void) {
+    double total = 0;
+    for (size_t i = 0; i < sizeof(day) / sizeof(*day); i++) {
+        if (!input[i].data) {
+            fprintf(stderr, "%-10s %10s\n", day[i].name, "no input");
+            continue;
+        }
+        printf("--- %s ---\n", day[i].name);
+        fflush(stdout);
+        char *args[] = {day[i].name, nullptr};
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        day[i].main(1, args);
+        fflush(stdout);
+        double seconds = elapsed(&start);
+        fprintf(stderr, "%-10s %10.3f ms\n", day[i].name, 1e3 * seconds);
+        total += seconds;
+    }
+    return total;
+}
@@ -0,0 +1,166 @@
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    const char *name;
+    FILE *output;
+    pid_t pid;
+    int status;
+    double seconds;
+} Job;
+
+void usage(const char *prog);
+long cpus_allowed(long *cpu, long max);
+void start(Job *job, long cpu);
+double seconds(const struct timeval *tv);
+double elapsed(const struct timespec *start);
+
+int main(int argc, char **argv) {
+    long workers = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:")) != -1) {
+        switch (opt) {
+            case 'j': workers = strtol(optarg, nullptr, 10); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (optind == argc) {
+        usage(argv[0]);
+    }
+
+    long cpus = CPU_SETSIZE;
+    long *cpu = calloc(cpus, sizeof(*cpu));
+    assert(cpu);
+    cpus = cpus_allowed(cpu, cpus);
+    if (workers < 1 || workers > cpus) {
+        workers = cpus;
+    }
+
+    long count = argc - optind;
+    Job *job = calloc(count, sizeof(*job));
+    long *slot = calloc(workers, sizeof(*slot));
+    assert(job && slot);
+    for (long i = 0; i < count; i++) {
+        job[i].name = argv[optind + i];
+    }
+
+    struct timespec begin;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    double cpu_time = 0;
+    long next = 0;
+    long running = 0;
+    for (long w = 0; w < workers && next < count; w++) {
+        slot[w] = next;
+        start(&job[next++], cpu[w]);
+        running += 1;
+    }
+    while (running) {
+        int status;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &status, 0, &usage);
+        assert(pid > 0);
+        for (long w = 0; w < workers; w++) {
+            Job *done = &job[slot[w]];
+            if (done->pid != pid) {
+                continue;
+            }
+            done->status = status;
+            done->seconds = seconds(&usage.ru_utime) + seconds(&usage.ru_stime);
+            cpu_time += done->seconds;
+            running -= 1;
+            if (next < count) {
+                slot[w] = next;
+                start(&job[next++], cpu[w]);
+                running += 1;
+            }
+            break;
+        }
+    }
+    double wall = elapsed(&begin);
+
+    long failed = 0;
+    for (long i = 0; i < count; i++) {
+        printf("--- %s ---\n", job[i].name);
+        fflush(stdout);
+        rewind(job[i].output);
+        char buf[1 << 16];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), job[i].output)) > 0) {
+            fwrite(buf, 1, n, stdout);
+        }
+        fflush(stdout);
+        fclose(job[i].output);
+        if (!WIFEXITED(job[i].status) || WEXITSTATUS(job[i].status)) {
+            fprintf(stderr, "%s: exited abnormally\n", job[i].name);
+            failed += 1;
+        }
+    }
+    fprintf(stderr, "%ld programs on %ld cpus: %.3f s wall, %.3f s cpu (%.1fx)\n", count, workers,
+            wall, cpu_time, wall > 0 ? cpu_time / wall : 0);
+
+    free(slot);
+    free(job);
+    free(cpu);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-j workers] prog...\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+long cpus_allowed(long *cpu, long max) {
+    cpu_set_t set;
+    long count = 0;
+    if (!sched_getaffinity(0, sizeof(set), &set)) {
+        for (long i = 0; i < CPU_SETSIZE && count < max; i++) {
+            if (CPU_ISSET(i, &set)) {
+                cpu[count++] = i;
+            }
+        }
+    }
+    if (count == 0) {
+        cpu[count++] = -1;
+    }
+    return count;
+}
+
+void start(Job *job, long cpu) {
+    job->output = tmpfile();
+    assert(job->output);
+    fflush(stdout);
+    job->pid = fork();
+    assert(job->pid >= 0);
+    if (job->pid == 0) {
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            sched_setaffinity(0, sizeof(set), &set);
+        }
+        dup2(fileno(job->output), STDOUT_FILENO);
+        char path[4096];
+        snprintf(path, sizeof(path), "./%s", job->name);
+        execl(path, path, (char *)nullptr);
+        _exit(127);
+    }
+}
+
+double seconds(const struct timeval *tv) {
+    return tv->tv_sec + (tv->tv_usec * 1e-6);
+}
+
+double elapsed(const struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) + ((end.tv_nsec - start->tv_nsec) * 1e-9);
+}